@@ -0,0 +1,83 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Times apply_moves() against apply_moves_scalar() on the same random 8x8 boards and checks they agree.
+
+
+#include "engine/batch.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+using namespace std;
+
+
+static const constexpr size_t boards_count = 1 << 14;
+static const constexpr size_t rounds       = 64;
+
+
+template <class F>
+static double time_rounds(const vector<bitboard> & boards, vector<move_result> & results, F && apply) {
+	vector<bitboard> scratch;
+	chrono::steady_clock::duration elapsed{};
+	for(auto i = 0u; i < rounds; ++i) {
+		scratch          = boards;
+		const auto start = chrono::steady_clock::now();
+		apply(scratch.data(), results.data());
+		elapsed += chrono::steady_clock::now() - start;
+	}
+	return chrono::duration<double, nano>(elapsed).count() / (rounds * boards.size());
+}
+
+static bool same(const move_result & lhs, const move_result & rhs) {
+	return lhs.moved == rhs.moved && lhs.end_x == rhs.end_x && lhs.end_y == rhs.end_y && lhs.length == rhs.length && lhs.score == rhs.score &&
+	       lhs.cleared == rhs.cleared;
+}
+
+
+int main() {
+	mt19937_64 engine(0x5EED);
+	vector<bitboard> boards;
+	vector<unsigned char> starts;
+	boards.reserve(boards_count);
+	starts.reserve(boards_count);
+	for(auto i = 0u; i < boards_count; ++i) {
+		boards.emplace_back(*to_bitboard(generate_board(bitboard::max_side, bitboard::max_side, engine)));
+		starts.emplace_back(engine() % (bitboard::max_side * bitboard::max_side));
+	}
+
+	vector<move_result> batched(boards_count), scalar(boards_count);
+	const auto batched_ns = time_rounds(boards, batched, [&](auto bbs, auto res) { apply_moves(bbs, starts.data(), res, boards_count); });
+	const auto scalar_ns  = time_rounds(boards, scalar, [&](auto bbs, auto res) { apply_moves_scalar(bbs, starts.data(), res, boards_count); });
+
+	for(auto i = 0u; i < boards_count; ++i)
+		if(!same(batched[i], scalar[i])) {
+			fprintf(stderr, "apply_moves() and apply_moves_scalar() disagree on board %u\n", i);
+			return 1;
+		}
+
+	printf("apply_moves():        %6.2f ns/board\n", batched_ns);
+	printf("apply_moves_scalar(): %6.2f ns/board\n", scalar_ns);
+	printf("speedup:              %6.2fx\n", scalar_ns / batched_ns);
+}
@@ -0,0 +1,104 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Measures how small each saving method gets gd.dat's payload, and how fast it gets there and back, on leaderboards shaped like real ones:
+// a handful of players setting most of the scores, which grow with the level reached.
+
+
+#include "game_data.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+using namespace std;
+
+
+static const constexpr saving_method methods[] = {saving_method::lz,  saving_method::fast_lz,      saving_method::huffman,
+                                                  saving_method::rice_8, saving_method::rice_unsigned_8, saving_method::rle,
+                                                  saving_method::shannon_fano};
+static const constexpr size_t highscore_counts[] = {leaderboard::default_capacity, 10000, 1000000};
+static const constexpr auto min_duration         = chrono::milliseconds(200);
+
+
+static game_data realistic_game_data(size_t highscores, mt19937_64 & engine) {
+	static const char * const regulars[] = {"nabijaczleweli", "mike", "anna", "Guest", "kuba", "root", "Julia", "tomek", "xXx_sniper_xXx", "ola"};
+
+	game_data res;
+	res.name = regulars[0];
+	res.highscore().capacity(highscores);
+
+	// Big leaderboards come from merging many players' saves, so they have more players, named like the regulars but less often
+	vector<string> players(begin(regulars), end(regulars));
+	while(players.size() < highscores / 100)
+		players.emplace_back(regulars[players.size() % extent<decltype(regulars)>::value] + to_string(players.size()));
+
+	// Player i sets roughly 1/(i + 1) as many scores as the first one; levels fall off geometrically
+	vector<double> weights;
+	for(auto i = 0u; i < players.size(); ++i)
+		weights.emplace_back(1. / (i + 1));
+	discrete_distribution<size_t> player(weights.begin(), weights.end());
+	geometric_distribution<uint16_t> levels_past_first(.3);
+	uniform_int_distribution<uint32_t> per_level(150, 450), leftover(0, 150);
+	while(res.highscore().size() < highscores) {
+		const auto level = static_cast<uint16_t>(levels_past_first(engine) + 1);
+		res.highscore().insert({players[player(engine)], level * per_level(engine) + leftover(engine), level});
+	}
+	return res;
+}
+
+// Runs func over and over for at least min_duration, returns how many MB/s of size bytes that was
+template <class F>
+static double throughput(size_t size, F && func) {
+	size_t runs = 0;
+	chrono::steady_clock::duration elapsed{};
+	const auto start = chrono::steady_clock::now();
+	for(; elapsed < min_duration; elapsed = chrono::steady_clock::now() - start, ++runs)
+		func();
+	return size * runs / chrono::duration<double, micro>(elapsed).count();
+}
+
+
+int main() {
+	mt19937_64 engine(0x5EED);
+	for(auto highscores : highscore_counts) {
+		const auto payload = encode_game_data(realistic_game_data(highscores, engine));
+		printf("%zu highscores, %zu bytes uncompressed\n", highscores, payload.size());
+		printf("  method   ratio  compress MB/s  decompress MB/s\n");
+
+		for(auto method : methods) {
+			const auto compressed = compress(method, payload.data(), payload.size());
+			if(decompress(method, compressed.data(), compressed.size(), payload.size()) != payload) {
+				fprintf(stderr, "Saving method %c doesn't round-trip\n", static_cast<char>(method));
+				return 1;
+			}
+
+			const auto compress_speed   = throughput(payload.size(), [&] { compress(method, payload.data(), payload.size()); });
+			const auto decompress_speed = throughput(payload.size(), [&] { decompress(method, compressed.data(), compressed.size(), payload.size()); });
+			printf("  %c       %6.3f  %13.1f  %15.1f\n", static_cast<char>(method), static_cast<double>(compressed.size()) / payload.size(), compress_speed,
+			       decompress_speed);
+		}
+	}
+}
@@ -0,0 +1,128 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "background_saver.hpp"
+
+#include <utility>
+
+#include "exceptions.hpp"
+
+
+using namespace std;
+using namespace std::experimental;
+
+
+background_saver::background_saver(saving_method pmethod, size_t phighscore_capacity, string pfilename)
+      : method(pmethod), highscore_capacity(phighscore_capacity), filename(move(pfilename)), journal_records(repair_journal(filename)), records_in_pending(0),
+        stopping(false),
+        worker(&background_saver::run, this) {}
+
+background_saver::~background_saver() {
+	{
+		lock_guard<mutex> lock(guard);
+		stopping = true;
+	}
+	wake.notify_one();
+	worker.join();
+}
+
+void background_saver::save(const game_data & gd) {
+	{
+		lock_guard<mutex> lock(guard);
+		pending            = gd;
+		records_in_pending = pending_records.size();
+	}
+	wake.notify_one();
+}
+
+void background_saver::record(const high_data & hd) {
+	{
+		lock_guard<mutex> lock(guard);
+		pending_records.emplace_back(hd);
+	}
+	wake.notify_one();
+}
+
+void background_saver::run() {
+	// Only touched here, off the lock
+	optional<game_data> unsaved;
+	vector<high_data> unjournalled;
+
+	unique_lock<mutex> lock(guard);
+	while(true) {
+		wake.wait(lock, [&] { return pending || !pending_records.empty() || stopping; });
+		const auto last_try = !pending && pending_records.empty();
+		if(last_try && !unsaved && unjournalled.empty())
+			return;
+
+		// Records are only ever newer than a snapshot taken before them, since record() requires them to be in the next one
+		auto gd            = move(pending);
+		auto records       = move(pending_records);
+		const auto in_gd   = records_in_pending;
+		pending            = nullopt;
+		records_in_pending = 0;
+		pending_records.clear();
+
+		lock.unlock();
+		const auto fresh = static_cast<bool>(gd);
+		if(gd)
+			unsaved = move(gd);
+		if(unsaved && save_game_data_to_file(*unsaved, method, filename)) {
+			unsaved = nullopt;
+			// An older snapshot that's only now been written doesn't have what was journalled after it was handed over, so the journal stays
+			if(fresh) {
+				clear_journal(filename);
+				journal_records = 0;
+				unjournalled.clear();
+				records.erase(records.begin(), records.begin() + in_gd);
+			}
+		}
+
+		unjournalled.insert(unjournalled.end(), records.begin(), records.end());
+		auto journalled = unjournalled.begin();
+		while(journalled != unjournalled.end() && append_to_journal(*journalled, filename))
+			++journalled;
+		journal_records += journalled - unjournalled.begin();
+		unjournalled.erase(unjournalled.begin(), journalled);
+
+		// Compacting under a snapshot that's yet to be written would have it overwrite what's compacted in
+		if(!unsaved && journal_records >= compaction_threshold)
+			compact();
+		lock.lock();
+
+		if(last_try)
+			return;
+	}
+}
+
+void background_saver::compact() {
+	// A save that can't be read is moved aside by loading, so compacting only the journal into its place loses nothing;
+	// one that can't even be moved is left for the next try
+	try {
+		const auto gd = load_game_data_from_file(method, highscore_capacity, filename);
+		if(save_game_data_to_file(gd, method, filename)) {
+			clear_journal(filename);
+			journal_records = 0;
+		}
+	} catch(simplesmart_exception &) {
+	}
+}
@@ -0,0 +1,72 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include <experimental/optional>
+
+#include "game_data.hpp"
+
+
+// Saves game data on a thread of its own, so the UI never waits on the disk.
+//
+// Only the latest snapshot handed over while a save is in progress gets written, earlier ones are dropped.
+// Single highscores are appended to the journal instead, which is folded back into the save once it reaches compaction_threshold records.
+// Whatever couldn't be written is kept and tried again along with the next snapshot or record, and once more when the saver is destroyed;
+// the journal is only ever cleared once a snapshot with everything in it is on the disk, and is cut back to its last whole record on construction.
+class background_saver {
+private:
+	saving_method method;
+	std::size_t highscore_capacity;
+	std::string filename;
+	std::size_t journal_records;
+
+	std::mutex guard;
+	std::condition_variable wake;
+	std::experimental::optional<game_data> pending;
+	std::vector<high_data> pending_records;
+	// How many of pending_records were there when pending was handed over, and so are in it
+	std::size_t records_in_pending;
+	bool stopping;
+
+	std::thread worker;
+
+	void run();
+	void compact();
+
+public:
+	static const constexpr std::size_t compaction_threshold = 256;
+
+
+	background_saver(saving_method method, std::size_t highscore_capacity, std::string filename = "gd.dat");
+	~background_saver();
+
+	void save(const game_data & gd);
+	// hd must already be in the game data the next save() gets
+	void record(const high_data & hd);
+};
@@ -0,0 +1,145 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "board_view.hpp"
+
+#include <algorithm>
+
+
+using namespace std;
+
+
+// Every packed cell, selected or not, mapped straight to what it looks like on screen
+struct cell_glyph_table {
+	chtype glyphs[1 << 7];
+
+	constexpr cell_glyph_table() : glyphs() {
+		for(auto i = 0u; i < sizeof(glyphs) / sizeof(*glyphs); ++i) {
+			packed_cell cell{};
+			cell.bits           = i & 0b111111;
+			const auto selected = i >> 6;
+
+			chtype glyph = ' ';
+			switch(cell.dir()) {
+				case direction::up:
+					glyph = up_pointing_moving_thing;
+					break;
+				case direction::right:
+					glyph = right_pointing_moving_thing;
+					break;
+				case direction::down:
+					glyph = down_pointing_moving_thing;
+					break;
+				case direction::left:
+					glyph = left_pointing_moving_thing;
+					break;
+				case direction::nonexistant:
+					break;
+			}
+
+			if(selected)
+				glyph |= A_BOLD;
+			else if(cell.col() != colour::none)
+				glyph |= COLOR_PAIR(static_cast<int>(cell.col()));
+			glyphs[i] = glyph;
+		}
+	}
+
+	constexpr chtype operator()(packed_cell cell, bool selected) const noexcept {
+		return glyphs[cell.bits | (selected << 6)];
+	}
+};
+
+static constexpr const cell_glyph_table cell_glyphs{};
+
+
+board_view::board_view(WINDOW * parent_window, const board & brd) : view_x(0), view_y(0), full_redraw(true), drawn_selected_x(0), drawn_selected_y(0) {
+	int maxX, maxY;
+	getmaxyx(parent_window, maxY, maxX);
+
+	view_width  = min(brd.width(), static_cast<unsigned int>(maxX));
+	view_height = min(brd.height(), static_cast<unsigned int>(maxY));
+	window.reset(derwin(parent_window, view_height, view_width, (maxY - view_height) / 2, (maxX - view_width) / 2));
+	row_buffer.resize(view_width);
+}
+
+void board_view::follow(unsigned int x, unsigned int y) noexcept {
+	const auto old_x = view_x;
+	const auto old_y = view_y;
+
+	if(x < view_x)
+		view_x = x;
+	else if(x >= view_x + view_width)
+		view_x = x - view_width + 1;
+
+	if(y < view_y)
+		view_y = y;
+	else if(y >= view_y + view_height)
+		view_y = y - view_height + 1;
+
+	if(view_x != old_x || view_y != old_y)
+		invalidate();
+}
+
+void board_view::invalidate() noexcept {
+	full_redraw = true;
+}
+
+vector<size_t> & board_view::dirty_cells() noexcept {
+	return dirty;
+}
+
+void board_view::draw(const board & brd, unsigned int selected_x, unsigned int selected_y) {
+	follow(selected_x, selected_y);
+
+	if(full_redraw) {
+		for(auto y = 0u; y < view_height; ++y)
+			draw_row(brd, view_y + y, selected_x, selected_y);
+		full_redraw = false;
+	} else {
+		vector<bool> dirty_rows(view_height);
+		for(auto idx : dirty) {
+			const auto y = idx / brd.width();
+			if(y >= view_y && y < view_y + view_height)
+				dirty_rows[y - view_y] = true;
+		}
+		dirty_rows[drawn_selected_y - view_y] = true;
+		dirty_rows[selected_y - view_y]       = true;
+
+		for(auto y = 0u; y < view_height; ++y)
+			if(dirty_rows[y])
+				draw_row(brd, view_y + y, selected_x, selected_y);
+	}
+	dirty.clear();
+
+	drawn_selected_x = selected_x;
+	drawn_selected_y = selected_y;
+	wnoutrefresh(window.get());
+	doupdate();
+}
+
+void board_view::draw_row(const board & brd, unsigned int y, unsigned int selected_x, unsigned int selected_y) {
+	const auto row = &brd.cells(y, view_x);
+	for(auto x = 0u; x < view_width; ++x)
+		row_buffer[x] = cell_glyphs(row[x], y == selected_y && view_x + x == selected_x);
+	mvwaddchnstr(window.get(), y - view_y, 0, row_buffer.data(), view_width);
+}
@@ -0,0 +1,67 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <vector>
+#include <cstddef>
+
+#include "curses.hpp"
+#include "engine/board.hpp"
+
+
+constexpr static const chtype right_pointing_moving_thing = ')';
+constexpr static const chtype left_pointing_moving_thing  = 'C';
+constexpr static const chtype up_pointing_moving_thing    = '^';
+constexpr static const chtype down_pointing_moving_thing  = 'U';
+
+
+// Window onto the part of a board that fits in the parent window, scrolled to follow the selected cell.
+//
+// Only rows with cells marked dirty and the old and new selection are redrawn, unless the view scrolled or was invalidated;
+// each row is a single curses call.
+class board_view {
+private:
+	window_p window;
+	unsigned int view_x;
+	unsigned int view_y;
+	unsigned int view_width;
+	unsigned int view_height;
+
+	bool full_redraw;
+	unsigned int drawn_selected_x;
+	unsigned int drawn_selected_y;
+	std::vector<std::size_t> dirty;
+	std::vector<chtype> row_buffer;
+
+	void draw_row(const board & brd, unsigned int y, unsigned int selected_x, unsigned int selected_y);
+
+public:
+	board_view(WINDOW * parent_window, const board & brd);
+
+	void follow(unsigned int x, unsigned int y) noexcept;
+	void invalidate() noexcept;
+	// Cell indices (y * width + x) that changed since the last draw, as collected by apply_move()
+	std::vector<std::size_t> & dirty_cells() noexcept;
+	void draw(const board & brd, unsigned int selected_x, unsigned int selected_y);
+};
@@ -0,0 +1,139 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "bit_packing.hpp"
+#include "codecs.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMPLESMART_UNPACK_X86 1
+#endif
+
+
+using namespace std;
+
+
+static unsigned int bit_width(uint32_t value) noexcept {
+	return value ? 32 - __builtin_clz(value) : 0;
+}
+
+static size_t packed_size(size_t count, unsigned int width) noexcept {
+	return (count * width + 7) / 8;
+}
+
+// The value at index, reading no further than the block's end
+static uint32_t unpack_one(const uint8_t * block, size_t block_bytes, size_t index, unsigned int width) noexcept {
+	const auto bit  = index * width;
+	const auto byte = bit / 8;
+
+	uint64_t word = 0;
+	memcpy(&word, block + byte, min<size_t>(sizeof(word), block_bytes - byte));
+	return (word >> (bit % 8)) & ((1ull << width) - 1);
+}
+
+static void unpack_block_scalar(const uint8_t * block, size_t block_bytes, uint32_t * out, size_t from, size_t count, unsigned int width) noexcept {
+	for(auto i = from; i < count; ++i)
+		out[i] = unpack_one(block, block_bytes, i, width);
+}
+
+#ifdef SIMPLESMART_UNPACK_X86
+// Four values at a time: gather the 64-bit words each one starts in, shift each into place and mask.
+// Stops before the first group whose words would reach past the block, the rest is left for the scalar path.
+__attribute__((target("avx2"))) static size_t unpack_block_avx2(const uint8_t * block, size_t block_bytes, uint32_t * out, size_t count,
+                                                                unsigned int width) noexcept {
+	const auto mask     = _mm256_set1_epi64x((1ll << width) - 1);
+	const auto lanes    = _mm256_setr_epi64x(0, 1, 2, 3);
+	const auto narrow   = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+	const auto width_64 = _mm256_set1_epi64x(width);
+
+	size_t i = 0;
+	for(; i + 4 <= count && ((i + 3) * width) / 8 + sizeof(uint64_t) <= block_bytes; i += 4) {
+		const auto bits  = _mm256_mul_epu32(_mm256_add_epi64(_mm256_set1_epi64x(i), lanes), width_64);
+		const auto bytes = _mm256_srli_epi64(bits, 3);
+		const auto words = _mm256_i64gather_epi64(reinterpret_cast<const long long *>(block), bytes, 1);
+		const auto value = _mm256_and_si256(_mm256_srlv_epi64(words, _mm256_and_si256(bits, _mm256_set1_epi64x(7))), mask);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(value, narrow)));
+	}
+	return i;
+}
+#endif
+
+
+void pack_column(const vector<uint32_t> & values, byte_buffer & out) {
+	for(size_t from = 0; from < values.size(); from += packed_block_size) {
+		const auto to    = min(values.size(), from + packed_block_size);
+		const auto width = bit_width(*max_element(values.begin() + from, values.begin() + to));
+		out.emplace_back(width);
+
+		uint64_t accumulator = 0;
+		auto pending         = 0u;
+		for(auto i = from; i < to; ++i) {
+			accumulator |= static_cast<uint64_t>(values[i]) << pending;
+			pending += width;
+			for(; pending >= 8; pending -= 8, accumulator >>= 8)
+				out.emplace_back(accumulator);
+		}
+		if(pending)
+			out.emplace_back(accumulator);
+	}
+}
+
+vector<uint32_t> unpack_column(const uint8_t * data, size_t size, size_t & position, size_t count) {
+#ifdef SIMPLESMART_UNPACK_X86
+	static const auto has_avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+	// Every block takes at least its width byte, so don't trust a count that couldn't fit
+	if(count > (size - min(position, size)) * packed_block_size)
+		corrupt_data("packed column");
+
+	vector<uint32_t> res(count);
+	for(size_t from = 0; from < count; from += packed_block_size) {
+		if(position == size)
+			corrupt_data("packed column");
+		const auto width = data[position++];
+		if(width > 32)
+			corrupt_data("packed column");
+
+		const auto values      = min(count - from, packed_block_size);
+		const auto block_bytes = packed_size(values, width);
+		if(block_bytes > size - position)
+			corrupt_data("packed column");
+
+		const auto block = data + position;
+		const auto out   = res.data() + from;
+		size_t done      = 0;
+		if(width) {
+#ifdef SIMPLESMART_UNPACK_X86
+			if(has_avx2)
+				done = unpack_block_avx2(block, block_bytes, out, values, width);
+#endif
+			unpack_block_scalar(block, block_bytes, out, done, values, width);
+		}
+		position += block_bytes;
+	}
+
+	return res;
+}
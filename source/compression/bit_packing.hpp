@@ -0,0 +1,48 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "compression.hpp"
+
+
+// LEB128, for lengths and offsets
+void put_varint(byte_buffer & out, std::size_t value);
+// Throws simplesmart_exception if the varint runs past size
+std::size_t get_varint(const std::uint8_t * data, std::size_t size, std::size_t & position);
+std::size_t varint_size(std::size_t value);
+
+
+// Columns of unsigned integers, bit-packed in blocks of packed_block_size values.
+//
+// Each block starts with a byte holding the bit width of its largest value, followed by the values at that width,
+// least significant bit first, padded to a whole byte.
+static const constexpr std::size_t packed_block_size = 128;
+
+void pack_column(const std::vector<std::uint32_t> & values, byte_buffer & out);
+// Reads count values starting at position and advances it; throws simplesmart_exception if the column runs past size
+std::vector<std::uint32_t> unpack_column(const std::uint8_t * data, std::size_t size, std::size_t & position, std::size_t count);
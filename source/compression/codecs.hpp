@@ -0,0 +1,95 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <cstddef>
+
+#include "compression.hpp"
+#include "bit_packing.hpp"
+
+
+// Codec entry points behind compress() and decompress(); decompressors throw simplesmart_exception on corrupt input
+
+byte_buffer rle_compress(const std::uint8_t * data, std::size_t size);
+byte_buffer rle_decompress(const std::uint8_t * data, std::size_t size, std::size_t original_size);
+
+byte_buffer lz_compress(const std::uint8_t * data, std::size_t size);
+byte_buffer lz_decompress(const std::uint8_t * data, std::size_t size, std::size_t original_size);
+
+byte_buffer fast_lz_compress(const std::uint8_t * data, std::size_t size);
+byte_buffer fast_lz_decompress(const std::uint8_t * data, std::size_t size, std::size_t original_size);
+
+byte_buffer huffman_compress(const std::uint8_t * data, std::size_t size);
+byte_buffer shannon_fano_compress(const std::uint8_t * data, std::size_t size);
+
+// Huffman and Shannon-Fano only differ in how code lengths are picked, the codes themselves are canonical and decode the same way
+using code_lengths_builder = void (*)(const std::size_t (&frequencies)[256], std::uint8_t (&lengths)[256]);
+byte_buffer prefix_code_compress(const std::uint8_t * data, std::size_t size, code_lengths_builder build_lengths);
+byte_buffer prefix_code_decompress(const std::uint8_t * data, std::size_t size, std::size_t original_size);
+
+byte_buffer rice_compress(const std::uint8_t * data, std::size_t size, bool is_signed);
+byte_buffer rice_decompress(const std::uint8_t * data, std::size_t size, std::size_t original_size, bool is_signed);
+
+
+// MSB-first bit packing for the entropy coders
+class bit_writer {
+private:
+	byte_buffer & out;
+	std::uint64_t accumulator;
+	unsigned int pending;
+
+public:
+	bit_writer(byte_buffer & out);
+
+	// count <= 32
+	void put(std::uint32_t value, unsigned int count);
+	// Pads the last byte with zeroes
+	void flush();
+};
+
+class bit_reader {
+private:
+	const std::uint8_t * data;
+	std::size_t size;
+	std::size_t position;
+	std::uint64_t accumulator;
+	unsigned int available;
+
+public:
+	bit_reader(const std::uint8_t * data, std::size_t size);
+
+	// count <= 32
+	std::uint32_t get(unsigned int count);
+};
+
+
+// The byte that occurs the least in data, used as the escape marker by RLE and LZ
+std::uint8_t least_frequent_byte(const std::uint8_t * data, std::size_t size);
+
+// How much of original_size a decompressor reserves up front; the size comes from the file, so a corrupt one can't ask for gigabytes
+std::size_t reservable_size(std::size_t original_size);
+
+// Throws simplesmart_exception naming the codec
+[[noreturn]] void corrupt_data(const char * codec);
@@ -0,0 +1,172 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "compression.hpp"
+#include "codecs.hpp"
+
+#include <unordered_map>
+
+#include "../exceptions.hpp"
+
+
+using namespace std;
+using namespace std::experimental;
+
+
+optional<saving_method> saving_method_from_name(const string & name) {
+	static const unordered_map<string, saving_method> names{{"l", saving_method::lz},     {"f", saving_method::fast_lz},         {"h", saving_method::huffman},
+	                                                        {"8", saving_method::rice_8}, {"u", saving_method::rice_unsigned_8}, {"r", saving_method::rle},
+	                                                        {"s", saving_method::shannon_fano}};
+
+	const auto itr = names.find(name);
+	if(itr == names.end())
+		return nullopt;
+	return make_optional(itr->second);
+}
+
+byte_buffer compress(saving_method method, const uint8_t * data, size_t size) {
+	switch(method) {
+		case saving_method::lz:
+			return lz_compress(data, size);
+		case saving_method::fast_lz:
+			return fast_lz_compress(data, size);
+		case saving_method::huffman:
+			return huffman_compress(data, size);
+		case saving_method::rice_8:
+			return rice_compress(data, size, true);
+		case saving_method::rice_unsigned_8:
+			return rice_compress(data, size, false);
+		case saving_method::rle:
+			return rle_compress(data, size);
+		case saving_method::shannon_fano:
+			return shannon_fano_compress(data, size);
+	}
+	throw simplesmart_exception("Unknown saving method " + to_string(static_cast<int>(method)));
+}
+
+byte_buffer decompress(saving_method method, const uint8_t * data, size_t size, size_t original_size) {
+	switch(method) {
+		case saving_method::lz:
+			return lz_decompress(data, size, original_size);
+		case saving_method::fast_lz:
+			return fast_lz_decompress(data, size, original_size);
+		case saving_method::huffman:
+		case saving_method::shannon_fano:
+			return prefix_code_decompress(data, size, original_size);
+		case saving_method::rice_8:
+			return rice_decompress(data, size, original_size, true);
+		case saving_method::rice_unsigned_8:
+			return rice_decompress(data, size, original_size, false);
+		case saving_method::rle:
+			return rle_decompress(data, size, original_size);
+	}
+	throw simplesmart_exception("Unknown saving method " + to_string(static_cast<int>(method)));
+}
+
+
+bit_writer::bit_writer(byte_buffer & pout) : out(pout), accumulator(0), pending(0) {}
+
+void bit_writer::put(uint32_t value, unsigned int count) {
+	accumulator = (accumulator << count) | (value & ((1ull << count) - 1));
+	pending += count;
+	while(pending >= 8) {
+		pending -= 8;
+		out.emplace_back(accumulator >> pending);
+	}
+	accumulator &= (1ull << pending) - 1;
+}
+
+void bit_writer::flush() {
+	if(pending)
+		out.emplace_back(accumulator << (8 - pending));
+	accumulator = 0;
+	pending     = 0;
+}
+
+
+bit_reader::bit_reader(const uint8_t * pdata, size_t psize) : data(pdata), size(psize), position(0), accumulator(0), available(0) {}
+
+uint32_t bit_reader::get(unsigned int count) {
+	while(available < count) {
+		if(position == size)
+			corrupt_data("bit stream");
+		accumulator = (accumulator << 8) | data[position++];
+		available += 8;
+	}
+
+	available -= count;
+	const auto res = (accumulator >> available) & ((1ull << count) - 1);
+	accumulator &= (1ull << available) - 1;
+	return res;
+}
+
+
+void put_varint(byte_buffer & out, size_t value) {
+	while(value >= 0x80) {
+		out.emplace_back((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	out.emplace_back(value);
+}
+
+size_t get_varint(const uint8_t * data, size_t size, size_t & position) {
+	size_t res = 0;
+	for(auto shift = 0u; shift < sizeof(size_t) * 8; shift += 7) {
+		if(position == size)
+			corrupt_data("varint");
+		const auto byte = data[position++];
+		res |= static_cast<size_t>(byte & 0x7F) << shift;
+		if(!(byte & 0x80))
+			return res;
+	}
+	corrupt_data("varint");
+}
+
+size_t varint_size(size_t value) {
+	size_t res = 1;
+	while(value >= 0x80) {
+		value >>= 7;
+		++res;
+	}
+	return res;
+}
+
+uint8_t least_frequent_byte(const uint8_t * data, size_t size) {
+	size_t frequencies[256]{};
+	for(auto i = 0u; i < size; ++i)
+		++frequencies[data[i]];
+
+	auto res = 0u;
+	for(auto i = 1u; i < 256; ++i)
+		if(frequencies[i] < frequencies[res])
+			res = i;
+	return res;
+}
+
+size_t reservable_size(size_t original_size) {
+	static const constexpr size_t max_reserved = 64 * 1024 * 1024;
+	return min(original_size, max_reserved);
+}
+
+void corrupt_data(const char * codec) {
+	throw simplesmart_exception(string("Corrupt ") + codec + " data");
+}
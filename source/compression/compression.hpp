@@ -0,0 +1,52 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <experimental/optional>
+
+
+using byte_buffer = std::vector<std::uint8_t>;
+
+
+// The "Saving method"s gd.dat can be compressed with; each one's value is its name in the config
+enum class saving_method : char {
+	lz              = 'l',
+	fast_lz         = 'f',
+	huffman         = 'h',
+	rice_8          = '8',
+	rice_unsigned_8 = 'u',
+	rle             = 'r',
+	shannon_fano    = 's',
+};
+
+
+std::experimental::optional<saving_method> saving_method_from_name(const std::string & name);
+
+byte_buffer compress(saving_method method, const std::uint8_t * data, std::size_t size);
+// Throws simplesmart_exception if data doesn't decompress to exactly original_size bytes
+byte_buffer decompress(saving_method method, const std::uint8_t * data, std::size_t size, std::size_t original_size);
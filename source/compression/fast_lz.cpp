@@ -0,0 +1,144 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "codecs.hpp"
+
+#include <vector>
+#include <algorithm>
+
+
+using namespace std;
+
+
+// Greedy LZ77 with a single hash probe per position and a 64KiB window, trading ratio for speed.
+//
+// The output is a list of sequences: a token with the literal count in the high nibble and match length - min_match in the low one,
+// each 15 continued in 255-saturated bytes, the literals, then the match offset as 16-bit little-endian.
+// The last sequence has only literals.
+static const constexpr size_t min_match     = 4;
+static const constexpr size_t max_offset    = 0xFFFF;
+static const constexpr size_t hash_bits     = 14;
+static const constexpr uint32_t no_position = ~0u;
+
+
+static uint32_t hash4(const uint8_t * at) {
+	const uint32_t word = at[0] | (at[1] << 8) | (at[2] << 16) | (static_cast<uint32_t>(at[3]) << 24);
+	return (word * 2654435761u) >> (32 - hash_bits);
+}
+
+static void put_length(byte_buffer & out, size_t length) {
+	for(; length >= 255; length -= 255)
+		out.emplace_back(255);
+	out.emplace_back(length);
+}
+
+static size_t get_length(const uint8_t * data, size_t size, size_t & position) {
+	size_t res = 0;
+	uint8_t byte;
+	do {
+		if(position == size)
+			corrupt_data("fast LZ");
+		byte = data[position++];
+		res += byte;
+	} while(byte == 255);
+	return res;
+}
+
+static void put_sequence(byte_buffer & out, const uint8_t * literals, size_t literal_count, size_t match_length, size_t offset) {
+	const auto match_code = match_length ? match_length - min_match : 0;
+	out.emplace_back((min<size_t>(literal_count, 15) << 4) | min<size_t>(match_code, 15));
+	if(literal_count >= 15)
+		put_length(out, literal_count - 15);
+	out.insert(out.end(), literals, literals + literal_count);
+
+	if(match_length) {
+		out.emplace_back(offset & 0xFF);
+		out.emplace_back(offset >> 8);
+		if(match_code >= 15)
+			put_length(out, match_code - 15);
+	}
+}
+
+
+byte_buffer fast_lz_compress(const uint8_t * data, size_t size) {
+	byte_buffer res;
+	res.reserve(size / 2 + 16);
+
+	vector<uint32_t> table(1 << hash_bits, no_position);
+	size_t literals_start = 0;
+	for(size_t i = 0; i + min_match <= size;) {
+		auto & slot          = table[hash4(data + i)];
+		const auto candidate = slot;
+		slot                 = i;
+
+		if(candidate == no_position || i - candidate > max_offset || !equal(data + i, data + i + min_match, data + candidate)) {
+			++i;
+			continue;
+		}
+
+		const auto length = mismatch(data + i + min_match, data + size, data + candidate + min_match).first - data - i;
+		put_sequence(res, data + literals_start, i - literals_start, length, i - candidate);
+		i += length;
+		literals_start = i;
+	}
+	put_sequence(res, data + literals_start, size - literals_start, 0, 0);
+
+	return res;
+}
+
+byte_buffer fast_lz_decompress(const uint8_t * data, size_t size, size_t original_size) {
+	byte_buffer res;
+	res.reserve(reservable_size(original_size));
+
+	for(size_t i = 0;;) {
+		if(i == size)
+			corrupt_data("fast LZ");
+		const auto token = data[i++];
+
+		auto literal_count = static_cast<size_t>(token >> 4);
+		if(literal_count == 15)
+			literal_count += get_length(data, size, i);
+		if(literal_count > size - i || literal_count > original_size - res.size())
+			corrupt_data("fast LZ");
+		res.insert(res.end(), data + i, data + i + literal_count);
+		i += literal_count;
+
+		if(res.size() == original_size && i == size)
+			break;
+
+		if(size - i < 2)
+			corrupt_data("fast LZ");
+		const size_t offset = data[i] | (data[i + 1] << 8);
+		i += 2;
+		auto match_length = static_cast<size_t>(token & 0x0F);
+		if(match_length == 15)
+			match_length += get_length(data, size, i);
+		match_length += min_match;
+
+		if(!offset || offset > res.size() || match_length > original_size - res.size())
+			corrupt_data("fast LZ");
+		for(auto from = res.size() - offset, end = from + match_length; from < end; ++from)
+			res.emplace_back(res[from]);
+	}
+
+	return res;
+}
@@ -0,0 +1,75 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "codecs.hpp"
+
+#include <queue>
+#include <vector>
+#include <utility>
+#include <functional>
+
+
+using namespace std;
+
+
+// Optimal code lengths, from merging the two least frequent subtrees until one is left
+static void huffman_code_lengths(const size_t (&frequencies)[256], uint8_t (&lengths)[256]) {
+	using subtree = pair<size_t, unsigned int>;
+	priority_queue<subtree, vector<subtree>, greater<subtree>> subtrees;
+	for(auto symbol = 0u; symbol < 256; ++symbol) {
+		lengths[symbol] = 0;
+		if(frequencies[symbol])
+			subtrees.emplace(frequencies[symbol], symbol);
+	}
+
+	if(subtrees.size() == 1) {
+		lengths[subtrees.top().second] = 1;
+		return;
+	}
+
+	// Leaves are 0..255, merged nodes follow
+	unsigned int parents[511];
+	auto next_node = 256u;
+	while(subtrees.size() > 1) {
+		const auto lhs = subtrees.top();
+		subtrees.pop();
+		const auto rhs = subtrees.top();
+		subtrees.pop();
+
+		parents[lhs.second] = parents[rhs.second] = next_node;
+		subtrees.emplace(lhs.first + rhs.first, next_node++);
+	}
+
+	const auto root = next_node - 1;
+	for(auto symbol = 0u; symbol < 256; ++symbol)
+		if(frequencies[symbol]) {
+			auto depth = 0u;
+			for(auto node = symbol; node != root; node = parents[node])
+				++depth;
+			lengths[symbol] = depth;
+		}
+}
+
+
+byte_buffer huffman_compress(const uint8_t * data, size_t size) {
+	return prefix_code_compress(data, size, huffman_code_lengths);
+}
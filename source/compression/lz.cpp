@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "codecs.hpp"
+
+#include <vector>
+#include <algorithm>
+
+
+using namespace std;
+
+
+// LZ77 over a 128KiB window, searching a hash chain deeply for the longest match.
+//
+// The least frequent byte marks matches: marker, length - min_match + 1 and offset as varints.
+// A literal marker byte is written as marker, 0.
+static const constexpr size_t min_match     = 4;
+static const constexpr size_t window_size   = 1 << 17;
+static const constexpr size_t hash_bits     = 16;
+static const constexpr size_t search_depth  = 256;
+static const constexpr uint32_t no_position = ~0u;
+
+
+static uint32_t hash4(const uint8_t * at) {
+	const uint32_t word = at[0] | (at[1] << 8) | (at[2] << 16) | (static_cast<uint32_t>(at[3]) << 24);
+	return (word * 2654435761u) >> (32 - hash_bits);
+}
+
+
+byte_buffer lz_compress(const uint8_t * data, size_t size) {
+	byte_buffer res;
+	res.reserve(size / 2 + 1);
+
+	const auto marker = least_frequent_byte(data, size);
+	res.emplace_back(marker);
+
+	vector<uint32_t> head(1 << hash_bits, no_position);
+	vector<uint32_t> chain(min(size, window_size), no_position);
+	const auto insert = [&](size_t at) {
+		if(at + min_match > size)
+			return;
+		auto & bucket                = head[hash4(data + at)];
+		chain[at & (window_size - 1)] = bucket;
+		bucket                       = at;
+	};
+
+	for(size_t i = 0; i < size;) {
+		size_t best_length = 0;
+		size_t best_offset = 0;
+		if(i + min_match <= size) {
+			auto candidate = head[hash4(data + i)];
+			for(auto depth = 0u; depth < search_depth && candidate != no_position && i - candidate <= window_size; ++depth) {
+				const auto length = mismatch(data + i, data + size, data + candidate).first - (data + i);
+				if(static_cast<size_t>(length) > best_length) {
+					best_length = length;
+					best_offset = i - candidate;
+				}
+				const auto next = chain[candidate & (window_size - 1)];
+				if(next == no_position || next >= candidate)
+					break;
+				candidate = next;
+			}
+		}
+
+		// Only worth it if the reference is shorter than the bytes it stands for
+		if(best_length >= min_match && 1 + varint_size(best_length - min_match + 1) + varint_size(best_offset) < best_length) {
+			res.emplace_back(marker);
+			put_varint(res, best_length - min_match + 1);
+			put_varint(res, best_offset);
+			for(auto end = i + best_length; i < end; ++i)
+				insert(i);
+		} else {
+			res.emplace_back(data[i]);
+			if(data[i] == marker)
+				res.emplace_back(0);
+			insert(i++);
+		}
+	}
+
+	return res;
+}
+
+byte_buffer lz_decompress(const uint8_t * data, size_t size, size_t original_size) {
+	if(!size)
+		corrupt_data("LZ");
+
+	byte_buffer res;
+	res.reserve(reservable_size(original_size));
+
+	const auto marker = data[0];
+	for(size_t i = 1; i < size;) {
+		const auto byte = data[i++];
+		if(byte != marker) {
+			res.emplace_back(byte);
+			continue;
+		}
+
+		const auto length = get_varint(data, size, i);
+		if(!length) {
+			res.emplace_back(marker);
+			continue;
+		}
+
+		const auto offset = get_varint(data, size, i);
+		const auto copy   = length + min_match - 1;
+		if(!offset || offset > res.size() || copy > original_size - min(res.size(), original_size))
+			corrupt_data("LZ");
+		for(auto from = res.size() - offset, end = from + copy; from < end; ++from)
+			res.emplace_back(res[from]);
+	}
+
+	if(res.size() != original_size)
+		corrupt_data("LZ");
+	return res;
+}
@@ -0,0 +1,125 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "codecs.hpp"
+
+#include <algorithm>
+
+
+using namespace std;
+
+
+// The code lengths of all 256 symbols come first, two to a byte, followed by the symbols' canonical codes.
+static const constexpr unsigned int max_code_length = 15;
+
+
+namespace {
+	struct canonical_code {
+		// Symbols sorted by code length, then value, and how many codes there are of each length
+		uint16_t counts[max_code_length + 1];
+		uint8_t symbols[256];
+		uint16_t codes[256];
+
+		canonical_code(const uint8_t (&lengths)[256]) : counts(), symbols(), codes() {
+			for(auto length : lengths)
+				++counts[length];
+			counts[0] = 0;
+
+			uint16_t offsets[max_code_length + 2]{};
+			uint16_t next_code[max_code_length + 1]{};
+			for(auto length = 1u, code = 0u; length <= max_code_length; ++length) {
+				offsets[length + 1] = offsets[length] + counts[length];
+				code                = (code + counts[length - 1]) << 1;
+				next_code[length]   = code;
+			}
+
+			for(auto symbol = 0u; symbol < 256; ++symbol)
+				if(const auto length = lengths[symbol]) {
+					symbols[offsets[length]++] = symbol;
+					codes[symbol]              = next_code[length]++;
+				}
+		}
+	};
+}
+
+
+byte_buffer prefix_code_compress(const uint8_t * data, size_t size, code_lengths_builder build_lengths) {
+	size_t frequencies[256]{};
+	for(auto i = 0u; i < size; ++i)
+		++frequencies[data[i]];
+
+	// Flattening the distribution until the codes fit costs a little ratio on pathological inputs only
+	uint8_t lengths[256]{};
+	while(build_lengths(frequencies, lengths), *max_element(begin(lengths), end(lengths)) > max_code_length)
+		for(auto & frequency : frequencies)
+			if(frequency)
+				frequency = (frequency >> 1) | 1;
+
+	byte_buffer res;
+	res.reserve(128 + size / 2);
+	for(auto i = 0u; i < 256; i += 2)
+		res.emplace_back((lengths[i] << 4) | lengths[i + 1]);
+
+	const canonical_code code(lengths);
+	bit_writer out(res);
+	for(auto i = 0u; i < size; ++i)
+		out.put(code.codes[data[i]], lengths[data[i]]);
+	out.flush();
+
+	return res;
+}
+
+byte_buffer prefix_code_decompress(const uint8_t * data, size_t size, size_t original_size) {
+	if(size < 128)
+		corrupt_data("prefix code");
+
+	uint8_t lengths[256];
+	for(auto i = 0u; i < 256; i += 2) {
+		lengths[i]     = data[i / 2] >> 4;
+		lengths[i + 1] = data[i / 2] & 0x0F;
+	}
+	const canonical_code code(lengths);
+
+	byte_buffer res;
+	res.reserve(reservable_size(original_size));
+
+	bit_reader in(data + 128, size - 128);
+	while(res.size() < original_size) {
+		int value = 0, first = 0, index = 0;
+		for(auto length = 1u;; ++length) {
+			if(length > max_code_length)
+				corrupt_data("prefix code");
+
+			value |= in.get(1);
+			const int count = code.counts[length];
+			if(value - first < count) {
+				res.emplace_back(code.symbols[index + value - first]);
+				break;
+			}
+			index += count;
+			first = (first + count) << 1;
+			value <<= 1;
+		}
+	}
+
+	return res;
+}
@@ -0,0 +1,102 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "codecs.hpp"
+
+
+using namespace std;
+
+
+// Each byte is split into a unary quotient and a k-bit remainder, with k following a running average of past values, so no table is stored.
+// Quotients of escape_quotient and more are written as that many 1 bits and the raw byte.
+// Signed bytes are zigzagged first, so small magnitudes of either sign get short codes.
+static const constexpr unsigned int escape_quotient = 16;
+
+
+namespace {
+	class rice_parameter {
+	private:
+		// 16 times the running average
+		unsigned int average = 0;
+
+	public:
+		unsigned int k() const noexcept {
+			auto res = 0u;
+			while(res < 7 && (2u << res) <= (average >> 4) + 1)
+				++res;
+			return res;
+		}
+
+		void update(uint8_t value) noexcept {
+			average += value - (average >> 4);
+		}
+	};
+}
+
+
+byte_buffer rice_compress(const uint8_t * data, size_t size, bool is_signed) {
+	byte_buffer res;
+	res.reserve(size);
+
+	bit_writer out(res);
+	rice_parameter parameter;
+	for(auto i = 0u; i < size; ++i) {
+		const uint8_t value = is_signed ? (data[i] << 1) ^ -(data[i] >> 7) : data[i];
+		const auto k        = parameter.k();
+
+		const auto quotient = static_cast<unsigned int>(value >> k);
+		if(quotient < escape_quotient) {
+			out.put(((1u << quotient) - 1) << 1, quotient + 1);
+			out.put(value, k);
+		} else {
+			out.put((1u << escape_quotient) - 1, escape_quotient);
+			out.put(value, 8);
+		}
+		parameter.update(value);
+	}
+	out.flush();
+
+	return res;
+}
+
+byte_buffer rice_decompress(const uint8_t * data, size_t size, size_t original_size, bool is_signed) {
+	byte_buffer res;
+	res.reserve(reservable_size(original_size));
+
+	bit_reader in(data, size);
+	rice_parameter parameter;
+	while(res.size() < original_size) {
+		const auto k = parameter.k();
+
+		auto quotient = 0u;
+		while(quotient < escape_quotient && in.get(1))
+			++quotient;
+
+		const uint8_t value = quotient < escape_quotient ? (quotient << k) | in.get(k) : in.get(8);
+		if(quotient < escape_quotient && static_cast<unsigned int>(value >> k) != quotient)
+			corrupt_data("Rice");
+		res.emplace_back(is_signed ? (value >> 1) ^ -(value & 1) : value);
+		parameter.update(value);
+	}
+
+	return res;
+}
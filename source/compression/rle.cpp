@@ -0,0 +1,102 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "codecs.hpp"
+
+#include <algorithm>
+
+
+using namespace std;
+
+
+// The least frequent byte marks runs: marker, run length - 1 as a varint, the repeated byte.
+// A literal marker byte is written as marker, 0; runs shorter than min_run of other bytes are copied as-is.
+static const constexpr size_t min_run = 4;
+
+
+byte_buffer rle_compress(const uint8_t * data, size_t size) {
+	byte_buffer res;
+	res.reserve(size / 2 + 1);
+
+	const auto marker = least_frequent_byte(data, size);
+	res.emplace_back(marker);
+
+	for(size_t i = 0; i < size;) {
+		const auto byte = data[i];
+		auto run        = find_if(data + i, data + size, [&](auto b) { return b != byte; }) - (data + i);
+
+		if(run >= static_cast<ptrdiff_t>(min_run)) {
+			res.emplace_back(marker);
+			put_varint(res, run - 1);
+			res.emplace_back(byte);
+		} else if(byte == marker) {
+			// A single escaped marker is as long as a run of it would be
+			if(run == 1) {
+				res.emplace_back(marker);
+				res.emplace_back(0);
+			} else {
+				res.emplace_back(marker);
+				put_varint(res, run - 1);
+				res.emplace_back(byte);
+			}
+		} else
+			res.insert(res.end(), run, byte);
+
+		i += run;
+	}
+
+	return res;
+}
+
+byte_buffer rle_decompress(const uint8_t * data, size_t size, size_t original_size) {
+	if(!size)
+		corrupt_data("RLE");
+
+	byte_buffer res;
+	res.reserve(reservable_size(original_size));
+
+	const auto marker = data[0];
+	for(size_t i = 1; i < size;) {
+		// Checked before every byte goes in, so the room left can't wrap around
+		if(res.size() == original_size)
+			corrupt_data("RLE");
+
+		const auto byte = data[i++];
+		if(byte != marker) {
+			res.emplace_back(byte);
+			continue;
+		}
+
+		const auto run = get_varint(data, size, i);
+		if(!run)
+			res.emplace_back(marker);
+		else {
+			if(i == size || run > original_size - res.size() - 1)
+				corrupt_data("RLE");
+			res.insert(res.end(), run + 1, data[i++]);
+		}
+	}
+
+	if(res.size() != original_size)
+		corrupt_data("RLE");
+	return res;
+}
@@ -0,0 +1,74 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "codecs.hpp"
+
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+
+
+using namespace std;
+
+
+static void split(const vector<uint8_t> & symbols, const vector<size_t> & running_total, size_t from, size_t to, uint8_t depth, uint8_t (&lengths)[256]) {
+	if(to - from == 1) {
+		lengths[symbols[from]] = depth;
+		return;
+	}
+
+	// Find the split point where both halves' total frequencies are the closest
+	const auto total = running_total[to] - running_total[from];
+	auto best        = from + 1;
+	for(auto at = from + 2; at < to; ++at)
+		if(llabs(static_cast<long long>(2 * (running_total[at] - running_total[from])) - static_cast<long long>(total)) <
+		   llabs(static_cast<long long>(2 * (running_total[best] - running_total[from])) - static_cast<long long>(total)))
+			best = at;
+
+	split(symbols, running_total, from, best, depth + 1, lengths);
+	split(symbols, running_total, best, to, depth + 1, lengths);
+}
+
+// Code lengths from recursively splitting the symbols, most frequent first, into two halves of about equal frequency
+static void shannon_fano_code_lengths(const size_t (&frequencies)[256], uint8_t (&lengths)[256]) {
+	vector<uint8_t> symbols;
+	for(auto symbol = 0u; symbol < 256; ++symbol) {
+		lengths[symbol] = 0;
+		if(frequencies[symbol])
+			symbols.emplace_back(symbol);
+	}
+	stable_sort(symbols.begin(), symbols.end(), [&](auto lhs, auto rhs) { return frequencies[lhs] > frequencies[rhs]; });
+
+	if(symbols.size() == 1)
+		lengths[symbols[0]] = 1;
+	else if(symbols.size() > 1) {
+		vector<size_t> running_total(symbols.size() + 1);
+		for(auto i = 0u; i < symbols.size(); ++i)
+			running_total[i + 1] = running_total[i] + frequencies[symbols[i]];
+		split(symbols, running_total, 0, symbols.size(), 0, lengths);
+	}
+}
+
+
+byte_buffer shannon_fano_compress(const uint8_t * data, size_t size) {
+	return prefix_code_compress(data, size, shannon_fano_code_lengths);
+}
@@ -33,6 +33,7 @@
 #include "tclap/CmdLine.h"
 
 #include "game_data.hpp"
+#include "engine/board.hpp"
 
 
 using namespace std;
@@ -40,50 +41,140 @@ using namespace std::experimental;
 using namespace TCLAP;
 
 
+// uint64_t and size_t are unsigned long long on MinGW-w64, which the bundled tclap only has traits for with HAVE_LONG_LONG
+#ifndef HAVE_LONG_LONG
+namespace TCLAP {
+	template <>
+	struct ArgTraits<unsigned long long> {
+		typedef ValueLike ValueCategory;
+	};
+}
+#endif
+
+
+// A config as read from its file, which may be from before some of the keys were added
+struct stored_config {
+	ass_config & config;
+	bool complete;
+};
+
+
 template <class Archive>
-void serialize(Archive & archive, ass_config & ac) {
+void save(Archive & archive, const ass_config & ac) {
 	archive(cereal::make_nvp("Matrix width", ac.matrix_width), cereal::make_nvp("Matrix height", ac.matrix_height),
 	        cereal::make_nvp("Screen width", ac.screen_width), cereal::make_nvp("Screen height", ac.screen_height),
-	        cereal::make_nvp("Put 'apo' in screens", ac.put_apo_in_screens));
+	        cereal::make_nvp("Put 'apo' in screens", ac.put_apo_in_screens), cereal::make_nvp("Board generator", ac.board_generator),
+	        cereal::make_nvp("Highscore capacity", ac.highscore_capacity), cereal::make_nvp("Saving method", ac.saving_method));
+}
+
+// Leaves value as it was if the key's missing or unreadable
+template <class Archive, class T>
+static bool load_optional(Archive & archive, const char * name, T & value) {
+	try {
+		archive(cereal::make_nvp(name, value));
+		return true;
+	} catch(cereal::Exception &) {
+	} catch(cereal::RapidJSONException &) {
+	}
+	return false;
+}
+
+template <class Archive>
+void load(Archive & archive, stored_config & sc) {
+	auto & ac   = sc.config;
+	sc.complete = load_optional(archive, "Matrix width", ac.matrix_width) & load_optional(archive, "Matrix height", ac.matrix_height) &
+	              load_optional(archive, "Screen width", ac.screen_width) & load_optional(archive, "Screen height", ac.screen_height) &
+	              load_optional(archive, "Put 'apo' in screens", ac.put_apo_in_screens) & load_optional(archive, "Board generator", ac.board_generator) &
+	              load_optional(archive, "Highscore capacity", ac.highscore_capacity) & load_optional(archive, "Saving method", ac.saving_method);
 }
 
 
-static pair<optional<string>, int> commandline_options(int argc, const char * const * argv);
+struct commandline_values {
+	string configfile;
+	optional<uint64_t> seed;
+	optional<string> legacy_save;
+	optional<merge_config> merge;
+};
+
+
+static pair<optional<commandline_values>, int> commandline_options(int argc, const char * const * argv);
 
 
 pair<optional<ass_config>, int> parse_options(int argc, const char * const * argv) {
 	const auto commandline = commandline_options(argc, argv);
 	if(!commandline.first)
 		return {nullopt, commandline.second};
-	const auto configfilename = commandline.first.value();
+	const auto configfilename = commandline.first.value().configfile;
 
 
 	ass_config cfg;
+	stored_config stored{cfg, false};
 	fstream configfile(configfilename, ios::in);
-	if(!configfile.is_open()) {
-		configfile.open(configfilename, ios::out);
-		cereal::JSONOutputArchive archive(configfile);
-		archive(cereal::make_nvp("apoSimpleSmart configuration", cfg));
-	} else {
-		cereal::JSONInputArchive archive(configfile);
+	// Written anew if it's missing, or lacks keys added since it was, with the defaults filling in for what's not there;
+	// one that can't be read at all is left for the user to fix
+	auto rewrite = true;
+	if(configfile.is_open())
 		try {
-			archive(cfg);
+			cereal::JSONInputArchive archive(configfile);
+			archive(stored);
+			rewrite = !stored.complete;
+		} catch(cereal::Exception &) {
+			rewrite = false;
 		} catch(cereal::RapidJSONException &) {
+			rewrite = false;
 		}
+
+	if(rewrite) {
+		configfile.close();
+		configfile.open(configfilename, ios::out | ios::trunc);
+		cereal::JSONOutputArchive archive(configfile);
+		archive(cereal::make_nvp("apoSimpleSmart configuration", cfg));
+	}
+
+	// Falling back to the defaults would have a misspelt name go unnoticed, and seeded games come out different from where they were recorded
+	if(!board_generator_from_name(cfg.board_generator)) {
+		cerr << configfilename << ": unknown \"Board generator\" \"" << cfg.board_generator << "\", expected philox, mt19937, xoshiro256**, pcg32 or splitmix64\n";
+		return {nullopt, 1};
 	}
+	if(!saving_method_from_name(cfg.saving_method)) {
+		cerr << configfilename << ": unknown \"Saving method\" \"" << cfg.saving_method << "\", expected l, f, h, 8, u, r or s\n";
+		return {nullopt, 1};
+	}
+
+	cfg.seed        = commandline.first.value().seed;
+	cfg.legacy_save = commandline.first.value().legacy_save;
+	cfg.merge       = commandline.first.value().merge;
 
 	return {make_optional(cfg), 0};
 }
 
 
-static pair<optional<string>, int> commandline_options(int argc, const char * const * argv) {
+static pair<optional<commandline_values>, int> commandline_options(int argc, const char * const * argv) {
 	try {
 		CmdLine command_line("apoSimpleSmart -- Curses clone of APO SimpleSmart Android game", ' ', __DATE__ " " __TIME__);
 
 		ValueArg<string> configfile("c", "configfile", "Use config file FILE; Default: simple_smart.cfg", false, "simple_smart.cfg", "FILE", command_line);
+		ValueArg<uint64_t> seed("s", "seed", "Generate boards from SEED, making runs reproducible; Default: random", false, 0, "SEED", command_line);
+		ValueArg<string> legacy_save("i", "import-legacy", "Import the highscores from legacy JSON save FILE, report how that went, and exit", false, "", "FILE",
+		                             command_line);
+		MultiArg<string> merge_inputs("m", "merge", "Merge the highscores of save FILE, JSON or binary, with those of the other ones given, and exit", false, "FILE",
+		                              command_line);
+		ValueArg<string> merge_output("o", "merge-output", "Write the merged save to FILE, merging in the one already there; Default: merged.dat", false,
+		                              "merged.dat", "FILE", command_line);
+		ValueArg<size_t> merge_top("n", "merge-top", "Keep the best N merged highscores; Default: Highscore capacity", false, 0, "N", command_line);
 		command_line.parse(argc, argv);
 
-		return {make_optional(regex_replace(configfile.getValue(), regex("\\\\"), "/")), 0};
+		commandline_values res{regex_replace(configfile.getValue(), regex("\\\\"), "/"), nullopt, nullopt, nullopt};
+		if(seed.isSet())
+			res.seed = seed.getValue();
+		if(legacy_save.isSet())
+			res.legacy_save = legacy_save.getValue();
+		if(merge_inputs.isSet()) {
+			res.merge = merge_config{merge_inputs.getValue(), merge_output.getValue(), nullopt};
+			if(merge_top.isSet())
+				res.merge->top = merge_top.getValue();
+		}
+		return {make_optional(res), 0};
 	} catch(const ArgException &) {
 	}
 	return {nullopt, 1};
@@ -23,10 +23,20 @@
 #pragma once
 
 
+#include <string>
+#include <vector>
+#include <cstdint>
 #include <utility>
 #include <experimental/optional>
 
 
+struct merge_config {
+	std::vector<std::string> inputs;
+	std::string output;
+	// Highscore capacity if not given
+	std::experimental::optional<std::size_t> top;
+};
+
 struct ass_config {
 	unsigned int matrix_width  = 7;
 	unsigned int matrix_height = 7;
@@ -34,6 +44,18 @@ struct ass_config {
 	unsigned int screen_height = 25;
 
 	bool put_apo_in_screens = false;
+
+	std::string board_generator = "philox";
+
+	unsigned int highscore_capacity = 100;
+
+	std::string saving_method = "f";
+
+	std::experimental::optional<std::uint64_t> seed;
+	// Import this legacy save into the current one and exit instead of playing
+	std::experimental::optional<std::string> legacy_save;
+	// Merge these saves into one and exit instead of playing
+	std::experimental::optional<merge_config> merge;
 };
 
 
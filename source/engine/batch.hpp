@@ -0,0 +1,36 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <cstddef>
+
+#include "bitboard.hpp"
+
+
+// Applies one move to each of count bitboards, leaving them and results as count apply_move(bitboard &, x, y) calls would.
+//
+// Starts are cell indices (y * 8 + x). Chains are walked several boards per instruction with AVX2 or SSE4.1 where the CPU supports them,
+// finished lanes masked out until the longest chain in the group ends.
+void apply_moves(bitboard * boards, const unsigned char * starts, move_result * results, std::size_t count) noexcept;
+void apply_moves_scalar(bitboard * boards, const unsigned char * starts, move_result * results, std::size_t count) noexcept;
@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "bitboard.hpp"
+
+
+using namespace std;
+using namespace std::experimental;
+
+
+static const constexpr uint64_t first_column = 0x0101010101010101ull;
+static const constexpr uint64_t last_column  = first_column << (bitboard::max_side - 1);
+
+
+optional<bitboard> to_bitboard(const board & brd) {
+	if(brd.width() > bitboard::max_side || brd.height() > bitboard::max_side)
+		return nullopt;
+
+	bitboard res{};
+	res.width  = brd.width();
+	res.height = brd.height();
+	for(auto y = 0u; y < brd.height(); ++y)
+		for(auto x = 0u; x < brd.width(); ++x) {
+			const auto bit  = cell_bit(x, y);
+			const auto & cl = brd.cells(y, x);
+
+			res.inside |= bit;
+			if(cl.dir() == direction::nonexistant)
+				continue;
+
+			res.occupied |= bit;
+			res.directions[static_cast<int>(cl.dir())] |= bit;
+			if(cl.col() != colour::none)
+				res.colours[static_cast<int>(cl.col()) - 1] |= bit;
+		}
+
+	return make_optional(res);
+}
+
+board to_board(const bitboard & bb) {
+	board res{decltype(board::cells)(bb.height, bb.width), 0};
+	res.touch();
+	for(auto y = 0u; y < bb.height; ++y)
+		for(auto x = 0u; x < bb.width; ++x) {
+			const auto bit = cell_bit(x, y);
+
+			cell cl{direction::nonexistant, colour::none};
+			for(auto i = 0; i < 4; ++i) {
+				if(bb.directions[i] & bit)
+					cl.dir = static_cast<direction>(i);
+				if(bb.colours[i] & bit)
+					cl.col = static_cast<colour>(i + 1);
+			}
+			res.cells(y, x) = cl;
+		}
+
+	return res;
+}
+
+uint64_t cell_bit(unsigned int x, unsigned int y) noexcept {
+	return 1ull << (y * bitboard::max_side + x);
+}
+
+uint64_t successors(const bitboard & bb, uint64_t from) noexcept {
+	const auto up    = (from & bb.directions[static_cast<int>(direction::up)]) >> bitboard::max_side;
+	const auto right = (from & bb.directions[static_cast<int>(direction::right)] & ~last_column) << 1;
+	const auto down  = (from & bb.directions[static_cast<int>(direction::down)]) << bitboard::max_side;
+	const auto left  = (from & bb.directions[static_cast<int>(direction::left)] & ~first_column) >> 1;
+
+	return (up | right | down | left) & bb.inside;
+}
+
+uint64_t coloured(const bitboard & bb) noexcept {
+	return bb.colours[0] | bb.colours[1] | bb.colours[2] | bb.colours[3];
+}
+
+move_result apply_move(bitboard & bb, unsigned int x, unsigned int y) noexcept {
+	move_result res{false, x, y, 0, 0, 0};
+
+	const auto start = cell_bit(x, y);
+	if(!(bb.occupied & start) || (coloured(bb) & start))
+		return res;
+
+	auto visited = start;
+	for(auto cur = start;;) {
+		cur = successors(bb, cur);
+		if(!cur || (cur & visited))
+			break;
+
+		visited |= cur;
+		++res.length;
+		++res.score;
+
+		if(coloured(bb) & cur) {
+			for(auto & col : bb.colours)
+				col &= ~cur;
+			++res.score;
+			++res.cleared;
+		}
+
+		const auto idx = __builtin_ctzll(cur);
+		res.end_x      = idx % bitboard::max_side;
+		res.end_y      = idx / bitboard::max_side;
+	}
+
+	bb.occupied &= ~start;
+	for(auto & dir : bb.directions)
+		dir &= ~start;
+	res.moved = true;
+	return res;
+}
+
+bool board_cleared(const bitboard & bb) noexcept {
+	return !coloured(bb);
+}
@@ -0,0 +1,54 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <experimental/optional>
+
+#include "board.hpp"
+
+
+// Boards of up to 8x8 cells, one bit per cell at y * 8 + x
+struct bitboard {
+	static const constexpr unsigned int max_side = 8;
+
+	std::uint64_t directions[4];  // Indexed by direction, up to left
+	std::uint64_t colours[4];     // Indexed by colour, blue to white
+	std::uint64_t occupied;
+	std::uint64_t inside;
+	unsigned char width;
+	unsigned char height;
+};
+
+
+std::experimental::optional<bitboard> to_bitboard(const board & brd);
+board to_board(const bitboard & bb);
+
+std::uint64_t cell_bit(unsigned int x, unsigned int y) noexcept;
+// Cells the chains from all of the specified cells step to at once
+std::uint64_t successors(const bitboard & bb, std::uint64_t from) noexcept;
+std::uint64_t coloured(const bitboard & bb) noexcept;
+
+move_result apply_move(bitboard & bb, unsigned int x, unsigned int y) noexcept;
+bool board_cleared(const bitboard & bb) noexcept;
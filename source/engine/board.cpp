@@ -0,0 +1,248 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "board.hpp"
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+
+using namespace std;
+using namespace std::experimental;
+
+
+// Below this many cells spinning up threads costs more than it saves
+static const constexpr size_t parallel_generation_threshold = 1 << 16;
+
+static cell cell_from_bits(uint64_t bits) noexcept {
+	return {static_cast<direction>(bits >> 62), static_cast<colour>(colour_distribution()(bits))};
+}
+
+
+unsigned int board::width() const noexcept {
+	return cells.cols();
+}
+
+unsigned int board::height() const noexcept {
+	return cells.rows();
+}
+
+void board::touch() noexcept {
+	static atomic<uint64_t> last_revision{0};
+	revision = ++last_revision;
+}
+
+
+optional<board_generator> board_generator_from_name(const string & name) {
+	static const unordered_map<string, board_generator> names{{"philox", board_generator::philox},
+	                                                          {"mt19937", board_generator::mt19937},
+	                                                          {"xoshiro256**", board_generator::xoshiro256starstar},
+	                                                          {"pcg32", board_generator::pcg32},
+	                                                          {"splitmix64", board_generator::splitmix64}};
+
+	const auto itr = names.find(name);
+	if(itr == names.end())
+		return nullopt;
+	return make_optional(itr->second);
+}
+
+const alias_table & colour_distribution() {
+	static const alias_table table({80, 5, 5, 5, 5});
+	return table;
+}
+
+board generate_board(unsigned int width, unsigned int height, uint64_t seed, board_generator generator) {
+	switch(generator) {
+		case board_generator::philox: {
+			board res{cell_matrix(height, width), 0};
+			res.touch();
+
+			const auto size    = static_cast<size_t>(width) * height;
+			const auto threads = size < parallel_generation_threshold ? 1u : min(max(thread::hardware_concurrency(), 1u), height);
+			if(threads == 1)
+				generate_region(res, seed, 0, 0, width, height);
+			else {
+				vector<thread> workers;
+				for(auto i = 0u; i < threads; ++i) {
+					const auto first = height * i / threads;
+					const auto last  = height * (i + 1) / threads;
+					workers.emplace_back([&, first, last]() { generate_region(res, seed, 0, first, width, last - first); });
+				}
+				for(auto & worker : workers)
+					worker.join();
+			}
+
+			return res;
+		}
+		case board_generator::mt19937: {
+			mt19937 engine(seed);
+			return generate_board(width, height, engine);
+		}
+		case board_generator::xoshiro256starstar: {
+			xoshiro256starstar engine(seed);
+			return generate_board(width, height, engine);
+		}
+		case board_generator::pcg32: {
+			pcg32 engine(seed);
+			return generate_board(width, height, engine);
+		}
+		case board_generator::splitmix64: {
+			splitmix64 engine(seed);
+			return generate_board(width, height, engine);
+		}
+	}
+	return {};
+}
+
+cell generate_cell(uint64_t seed, unsigned int x, unsigned int y) noexcept {
+	const auto block = philox4x32_10({{x >> 1, y, 0, 0}}, seed);
+	const auto half  = (x & 1) * 2;
+	return cell_from_bits((static_cast<uint64_t>(block[half]) << 32) | block[half + 1]);
+}
+
+void generate_region(board & brd, uint64_t seed, unsigned int x, unsigned int y, unsigned int width, unsigned int height) noexcept {
+	if(!width)
+		return;
+
+	for(auto cur_y = y; cur_y < y + height; ++cur_y) {
+		auto row   = &brd.cells(cur_y, 0);
+		auto cur_x = x;
+
+		if(cur_x & 1) {
+			row[cur_x] = generate_cell(seed, cur_x, cur_y);
+			++cur_x;
+		}
+		for(; cur_x + 1 < x + width; cur_x += 2) {
+			const auto block = philox4x32_10({{cur_x >> 1, cur_y, 0, 0}}, seed);
+			row[cur_x]       = cell_from_bits((static_cast<uint64_t>(block[0]) << 32) | block[1]);
+			row[cur_x + 1]   = cell_from_bits((static_cast<uint64_t>(block[2]) << 32) | block[3]);
+		}
+		if(cur_x < x + width)
+			row[cur_x] = generate_cell(seed, cur_x, cur_y);
+	}
+}
+
+move_result apply_move(board & brd, unsigned int x, unsigned int y, vector<size_t> * changed) {
+	move_result res{false, x, y, 0, 0, 0};
+	if(brd.cells(y, x).col() != colour::none || brd.cells(y, x).dir() == direction::nonexistant)
+		return res;
+
+	const auto width = brd.width();
+	const auto start = static_cast<size_t>(y) * width + x;
+
+	// Brent's algorithm: a chain that loops back on itself stops right before re-entering a cell,
+	// found in O(path length) time without a visited set the size of the board
+	auto max_length = numeric_limits<size_t>::max();
+	{
+		size_t power  = 1;
+		size_t lambda = 1;
+		auto tortoise = start;
+		auto hare     = successor(brd, start);
+		while(hare != no_successor && tortoise != hare) {
+			if(power == lambda) {
+				tortoise = hare;
+				power *= 2;
+				lambda = 0;
+			}
+			hare = successor(brd, hare);
+			++lambda;
+		}
+
+		if(hare != no_successor) {
+			tortoise = hare = start;
+			for(size_t i = 0; i < lambda; ++i)
+				hare = successor(brd, hare);
+
+			size_t mu = 0;
+			for(; tortoise != hare; ++mu) {
+				tortoise = successor(brd, tortoise);
+				hare     = successor(brd, hare);
+			}
+
+			max_length = mu + lambda - 1;
+		}
+	}
+
+	for(auto cur = start; res.length < max_length;) {
+		cur = successor(brd, cur);
+		if(cur == no_successor)
+			break;
+
+		res.end_x = cur % width;
+		res.end_y = cur / width;
+		++res.length;
+		++res.score;
+
+		auto & reached = brd.cells(res.end_y, res.end_x);
+		if(reached.col() != colour::none) {
+			reached.col(colour::none);
+			++res.score;
+			++res.cleared;
+			if(changed)
+				changed->emplace_back(cur);
+		}
+	}
+
+	brd.cells(y, x).dir(direction::nonexistant);
+	if(changed)
+		changed->emplace_back(start);
+	brd.touch();
+	res.moved = true;
+	return res;
+}
+
+size_t successor(const board & brd, size_t idx) {
+	const auto width = brd.width();
+	const auto x     = idx % width;
+	const auto y     = idx / width;
+
+	switch(brd.cells(y, x).dir()) {
+		case direction::up:
+			return y ? idx - width : no_successor;
+		case direction::right:
+			return x + 1 < width ? idx + 1 : no_successor;
+		case direction::down:
+			return y + 1 < brd.height() ? idx + width : no_successor;
+		case direction::left:
+			return x ? idx - 1 : no_successor;
+		case direction::nonexistant:
+			break;
+	}
+	return no_successor;
+}
+
+unsigned int remaining_coloured(const board & brd) {
+	auto res = 0u;
+	for(auto y = 0u; y < brd.height(); ++y)
+		for(auto x = 0u; x < brd.width(); ++x)
+			if(brd.cells(y, x).dir() != direction::nonexistant && brd.cells(y, x).col() != colour::none)
+				++res;
+	return res;
+}
+
+bool board_cleared(const board & brd) {
+	return !remaining_coloured(brd);
+}
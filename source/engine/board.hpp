@@ -0,0 +1,95 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <experimental/optional>
+
+#include "cell.hpp"
+#include "random.hpp"
+
+
+struct board {
+	cell_matrix cells;
+	std::uint64_t revision;
+
+	unsigned int width() const noexcept;
+	unsigned int height() const noexcept;
+
+	// Gives the board a revision no other board state has had, for caches keyed on it
+	void touch() noexcept;
+};
+
+enum class board_generator { philox, mt19937, xoshiro256starstar, pcg32, splitmix64 };
+
+struct move_result {
+	bool moved;
+	unsigned int end_x;
+	unsigned int end_y;
+	unsigned int length;
+	unsigned int score;
+	unsigned int cleared;  // Coloured cells the chain emptied, so callers can count down without rescanning the board
+};
+
+
+static const constexpr auto no_successor = std::numeric_limits<std::size_t>::max();
+
+
+std::experimental::optional<board_generator> board_generator_from_name(const std::string & name);
+const alias_table & colour_distribution();
+
+template <class Engine, class = typename Engine::result_type>
+board generate_board(unsigned int width, unsigned int height, Engine & engine);
+board generate_board(unsigned int width, unsigned int height, std::uint64_t seed, board_generator generator = board_generator::philox);
+// The cell board_generator::philox puts at (x, y), independent of every other cell and of the board's size
+cell generate_cell(std::uint64_t seed, unsigned int x, unsigned int y) noexcept;
+// Regenerates the specified region as board_generator::philox would have generated it
+void generate_region(board & brd, std::uint64_t seed, unsigned int x, unsigned int y, unsigned int width, unsigned int height) noexcept;
+// Indices (y * width + x) of the cells the move altered are appended to changed, if specified
+move_result apply_move(board & brd, unsigned int x, unsigned int y, std::vector<std::size_t> * changed = nullptr);
+// Index (y * width + x) of the cell a chain moves to from the one at idx, or no_successor if it stops there
+std::size_t successor(const board & brd, std::size_t idx);
+unsigned int remaining_coloured(const board & brd);
+bool board_cleared(const board & brd);
+
+
+template <class Engine, class>
+board generate_board(unsigned int width, unsigned int height, Engine & engine) {
+	board res{cell_matrix(height, width), 0};
+	res.touch();
+
+	const auto & colours = colour_distribution();
+	const auto data      = res.cells.data();
+	const auto size      = static_cast<std::size_t>(width) * height;
+	for(std::size_t i = 0; i < size; ++i) {
+		const auto bits = random_bits(engine);
+		data[i]         = cell{static_cast<direction>(bits >> 62), static_cast<colour>(colours(bits))};
+	}
+
+	return res;
+}
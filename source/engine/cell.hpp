@@ -0,0 +1,114 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+enum class direction : char { up, right, down, left, nonexistant };
+enum class colour : int { none, blue, red, green, white };
+
+struct cell {
+	direction dir;
+	colour col;
+};
+
+
+// Bits 0-1 are the direction, 2-4 the colour, 5 whether the cell exists at all
+class packed_cell {
+private:
+	static const constexpr std::uint8_t direction_mask = 0b000011;
+	static const constexpr std::uint8_t colour_mask    = 0b011100;
+	static const constexpr std::uint8_t exists_mask    = 0b100000;
+	static const constexpr unsigned int colour_shift   = 2;
+
+public:
+	std::uint8_t bits;
+
+
+	constexpr packed_cell() noexcept : bits(0) {}
+	constexpr packed_cell(const cell & cl) noexcept
+	      : bits((cl.dir == direction::nonexistant ? 0 : exists_mask | static_cast<std::uint8_t>(cl.dir)) |
+	             static_cast<std::uint8_t>(static_cast<int>(cl.col) << colour_shift)) {}
+
+	constexpr direction dir() const noexcept {
+		return (bits & exists_mask) ? static_cast<direction>(bits & direction_mask) : direction::nonexistant;
+	}
+
+	constexpr colour col() const noexcept {
+		return static_cast<colour>((bits & colour_mask) >> colour_shift);
+	}
+
+	void dir(direction d) noexcept {
+		bits = (bits & colour_mask) | (d == direction::nonexistant ? 0 : exists_mask | static_cast<std::uint8_t>(d));
+	}
+
+	void col(colour c) noexcept {
+		bits = (bits & ~colour_mask) | static_cast<std::uint8_t>(static_cast<int>(c) << colour_shift);
+	}
+
+	constexpr operator cell() const noexcept {
+		return {dir(), col()};
+	}
+};
+
+static_assert(sizeof(packed_cell) == 1, "packed_cell must stay one byte");
+
+
+// Row-major, one byte per cell, indexed (row, col)
+class cell_matrix {
+private:
+	std::vector<packed_cell> cells;
+	unsigned int width;
+
+public:
+	cell_matrix() noexcept : width(0) {}
+	cell_matrix(unsigned int rows, unsigned int cols) : cells(static_cast<std::size_t>(rows) * cols), width(cols) {}
+
+	packed_cell & operator()(unsigned int row, unsigned int col) noexcept {
+		return cells[static_cast<std::size_t>(row) * width + col];
+	}
+
+	const packed_cell & operator()(unsigned int row, unsigned int col) const noexcept {
+		return cells[static_cast<std::size_t>(row) * width + col];
+	}
+
+	unsigned int rows() const noexcept {
+		return width ? cells.size() / width : 0;
+	}
+
+	unsigned int cols() const noexcept {
+		return width;
+	}
+
+	packed_cell * data() noexcept {
+		return cells.data();
+	}
+
+	const packed_cell * data() const noexcept {
+		return cells.data();
+	}
+};
@@ -0,0 +1,107 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "chain_resolver.hpp"
+
+#include <algorithm>
+
+
+using namespace std;
+
+
+static unsigned int coloured(const board & brd, size_t idx) {
+	return brd.cells(idx / brd.width(), idx % brd.width()).col() != colour::none;
+}
+
+
+const chain & chain_resolver::resolve(const board & brd, unsigned int x, unsigned int y) {
+	return resolve(brd)[y * brd.width() + x];
+}
+
+const vector<chain> & chain_resolver::resolve(const board & brd) {
+	if(resolved_board != &brd || resolved_revision != brd.revision) {
+		resolve_all(brd);
+		resolved_board    = &brd;
+		resolved_revision = brd.revision;
+	}
+	return chains;
+}
+
+void chain_resolver::resolve_all(const board & brd) {
+	enum class state : unsigned char { unvisited, on_path, done };
+
+	const auto width = brd.width();
+	const auto size  = static_cast<size_t>(width) * brd.height();
+	chains.resize(size);
+
+	vector<state> states(size, state::unvisited);
+	vector<size_t> path;
+
+	for(size_t start = 0; start < size; ++start) {
+		if(states[start] != state::unvisited)
+			continue;
+
+		for(auto cur = start;;) {
+			states[cur] = state::on_path;
+			path.emplace_back(cur);
+
+			const auto next = successor(brd, cur);
+			if(next == no_successor) {
+				chains[cur] = {static_cast<unsigned int>(cur % width), static_cast<unsigned int>(cur / width), 0, 0, false};
+				states[cur] = state::done;
+				path.pop_back();
+				break;
+			} else if(states[next] == state::done)
+				break;
+			else if(states[next] == state::on_path) {
+				const auto cycle_begin = find(path.begin(), path.end(), next);
+				const auto cycle_len   = static_cast<unsigned int>(path.end() - cycle_begin);
+
+				auto cycle_coloured = 0u;
+				for(auto itr = cycle_begin; itr != path.end(); ++itr)
+					cycle_coloured += coloured(brd, *itr);
+
+				auto predecessor = path.back();
+				for(auto itr = cycle_begin; itr != path.end(); ++itr) {
+					chains[*itr] = {static_cast<unsigned int>(predecessor % width), static_cast<unsigned int>(predecessor / width), cycle_len - 1,
+					                cycle_len - 1 + cycle_coloured - coloured(brd, *itr), true};
+					states[*itr] = state::done;
+					predecessor  = *itr;
+				}
+				path.erase(cycle_begin, path.end());
+				break;
+			}
+
+			cur = next;
+		}
+
+		while(!path.empty()) {
+			const auto cur    = path.back();
+			const auto next   = successor(brd, cur);
+			const auto & tail = chains[next];
+
+			chains[cur] = {tail.end_x, tail.end_y, tail.length + 1, tail.score + 1 + coloured(brd, next), tail.cyclic};
+			states[cur] = state::done;
+			path.pop_back();
+		}
+	}
+}
@@ -0,0 +1,56 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <vector>
+
+#include "board.hpp"
+
+
+struct chain {
+	unsigned int end_x;
+	unsigned int end_y;
+	unsigned int length;
+	unsigned int score;
+	bool cyclic;
+};
+
+
+// Resolves what a move from every cell would do in one pass over the board's functional graph.
+//
+// A chain stops at the board's edge, on a nonexistant cell, or right before it would re-enter a cell it has already visited.
+// Results are cached until the board's revision changes.
+class chain_resolver {
+private:
+	const board * resolved_board = nullptr;
+	std::uint64_t resolved_revision;
+	std::vector<chain> chains;
+
+	void resolve_all(const board & brd);
+
+public:
+	const chain & resolve(const board & brd, unsigned int x, unsigned int y);
+	const std::vector<chain> & resolve(const board & brd);
+};
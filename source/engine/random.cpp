@@ -0,0 +1,69 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "random.hpp"
+
+#include <numeric>
+
+
+using namespace std;
+
+
+alias_table::alias_table(initializer_list<double> weights) : thresholds(weights.size()), aliases(weights.size()) {
+	const auto count = weights.size();
+	const auto total = accumulate(weights.begin(), weights.end(), 0.);
+
+	vector<double> scaled;
+	scaled.reserve(count);
+	for(auto weight : weights)
+		scaled.emplace_back(weight * count / total);
+
+	vector<unsigned int> small, large;
+	for(auto i = 0u; i < count; ++i)
+		(scaled[i] < 1 ? small : large).emplace_back(i);
+
+	const auto to_threshold = [](double probability) {
+		return probability >= 1 ? numeric_limits<uint32_t>::max() : static_cast<uint32_t>(probability * 4294967296.);
+	};
+
+	while(!small.empty() && !large.empty()) {
+		const auto less = small.back();
+		const auto more = large.back();
+		small.pop_back();
+		large.pop_back();
+
+		thresholds[less] = to_threshold(scaled[less]);
+		aliases[less]    = more;
+
+		scaled[more] -= 1 - scaled[less];
+		(scaled[more] < 1 ? small : large).emplace_back(more);
+	}
+
+	for(auto i : large) {
+		thresholds[i] = numeric_limits<uint32_t>::max();
+		aliases[i]    = i;
+	}
+	for(auto i : small) {
+		thresholds[i] = numeric_limits<uint32_t>::max();
+		aliases[i]    = i;
+	}
+}
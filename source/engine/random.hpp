@@ -0,0 +1,186 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <array>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <initializer_list>
+
+
+// Small-state UniformRandomBitGenerators for mass board generation; all seed from a single 64-bit value
+
+
+class splitmix64 {
+private:
+	std::uint64_t state;
+
+public:
+	using result_type = std::uint64_t;
+
+	static constexpr result_type min() noexcept {
+		return 0;
+	}
+
+	static constexpr result_type max() noexcept {
+		return std::numeric_limits<result_type>::max();
+	}
+
+
+	explicit splitmix64(std::uint64_t seed) noexcept : state(seed) {}
+
+	result_type operator()() noexcept {
+		auto z = (state += 0x9E3779B97F4A7C15ull);
+		z      = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z      = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+};
+
+class xoshiro256starstar {
+private:
+	std::uint64_t state[4];
+
+	static constexpr std::uint64_t rotl(std::uint64_t x, int k) noexcept {
+		return (x << k) | (x >> (64 - k));
+	}
+
+public:
+	using result_type = std::uint64_t;
+
+	static constexpr result_type min() noexcept {
+		return 0;
+	}
+
+	static constexpr result_type max() noexcept {
+		return std::numeric_limits<result_type>::max();
+	}
+
+
+	explicit xoshiro256starstar(std::uint64_t seed) noexcept {
+		splitmix64 seeder(seed);
+		for(auto & s : state)
+			s = seeder();
+	}
+
+	result_type operator()() noexcept {
+		const auto result = rotl(state[1] * 5, 7) * 9;
+		const auto t      = state[1] << 17;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl(state[3], 45);
+
+		return result;
+	}
+};
+
+class pcg32 {
+private:
+	static const constexpr std::uint64_t multiplier = 6364136223846793005ull;
+
+	std::uint64_t state;
+	std::uint64_t increment;
+
+public:
+	using result_type = std::uint32_t;
+
+	static constexpr result_type min() noexcept {
+		return 0;
+	}
+
+	static constexpr result_type max() noexcept {
+		return std::numeric_limits<result_type>::max();
+	}
+
+
+	explicit pcg32(std::uint64_t seed, std::uint64_t stream = 0xDA3E39CB94B95BDBull) noexcept : state(0), increment((stream << 1) | 1) {
+		(*this)();
+		state += seed;
+		(*this)();
+	}
+
+	result_type operator()() noexcept {
+		const auto old = state;
+		state          = old * multiplier + increment;
+
+		const auto xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+		const auto rot        = static_cast<std::uint32_t>(old >> 59);
+		return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+	}
+};
+
+
+// Counter-based: every output block is a pure function of (counter, key), so any block can be produced independently of all others
+inline std::array<std::uint32_t, 4> philox4x32_10(std::array<std::uint32_t, 4> counter, std::uint64_t key) noexcept {
+	auto key_low  = static_cast<std::uint32_t>(key);
+	auto key_high = static_cast<std::uint32_t>(key >> 32);
+	for(auto round = 0; round < 10; ++round) {
+		const auto product0 = static_cast<std::uint64_t>(0xD2511F53u) * counter[0];
+		const auto product1 = static_cast<std::uint64_t>(0xCD9E8D57u) * counter[2];
+
+		counter = {{static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key_low, static_cast<std::uint32_t>(product1),
+		            static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key_high, static_cast<std::uint32_t>(product0)}};
+		key_low += 0x9E3779B9u;
+		key_high += 0xBB67AE85u;
+	}
+	return counter;
+}
+
+
+// 64 random bits out of one or two engine calls
+template <class Engine>
+std::uint64_t random_bits(Engine & engine) {
+	static_assert(Engine::min() == 0, "random_bits() needs an engine covering whole words");
+	static_assert(Engine::max() == std::numeric_limits<std::uint32_t>::max() || Engine::max() == std::numeric_limits<std::uint64_t>::max(),
+	              "random_bits() needs an engine covering whole words");
+
+	if(Engine::max() == std::numeric_limits<std::uint64_t>::max())
+		return engine();
+	else {
+		const std::uint64_t high = engine();
+		return (high << 32) | static_cast<std::uint32_t>(engine());
+	}
+}
+
+
+// Walker/Vose alias table: an O(1) draw from a fixed discrete distribution.
+// Uses only the low 62 bits of its input, 30 for the column and 32 for the threshold, leaving the top two free.
+class alias_table {
+private:
+	std::vector<std::uint32_t> thresholds;
+	std::vector<unsigned int> aliases;
+
+public:
+	alias_table(std::initializer_list<double> weights);
+
+	unsigned int operator()(std::uint64_t bits) const noexcept {
+		const auto column = static_cast<unsigned int>((((bits >> 32) & 0x3FFFFFFF) * thresholds.size()) >> 30);
+		return static_cast<std::uint32_t>(bits) < thresholds[column] ? column : aliases[column];
+	}
+};
@@ -22,16 +22,64 @@
 
 #include "game_data.hpp"
 
+#include <limits>
+#include <vector>
+#include <cstdio>
 #include <fstream>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <unordered_map>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <io.h>
+#include <fcntl.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "cereal/cereal.hpp"
 #include "cereal/types/vector.hpp"
-#include "cereal/archives/json.hpp"
+#include "cereal/archives/portable_binary.hpp"
+#include "seed11/seed_device.hpp"
 
+#include "exceptions.hpp"
+#include "legacy_save.hpp"
 #include "rust_helpers.hpp"
+#include "compression/bit_packing.hpp"
 
 
 using namespace std;
+using namespace std::experimental;
+
+
+// Binary saves start with the magic and a format version byte; older, JSON, saves start with '{'.
+// Version 1 is followed by the portable binary archive itself.
+// Versions 2 and up are followed by the saving method, the payload's size as 32-bit little-endian, and the payload compressed with that method;
+// version 2's payload is the portable binary archive, versions 3 and 4 the columnar layout from encode_game_data().
+// Version 4 has a random 64-bit little-endian serial between the version and the saving method, which the index beside the save is written with.
+static const constexpr char save_magic[]                 = {'a', 'S', 'S', 'g', 'd'};
+static const constexpr unsigned char save_format_version = 4;
+
+// The journal beside a save holds highscores recorded since it was last written whole, as fixed-size records:
+// the name, zero-padded to max_name_length bytes, score and level as little-endian, and a Fletcher-16 of all that.
+// A torn last record fails its checksum and is ignored, as are entries already in the save, since the leaderboard drops duplicates.
+static const constexpr size_t journal_record_size = game_data::max_name_length + 4 + 2 + 2;
+
+
+const constexpr size_t game_data::max_name_length;
+
+
+// A save being read into gd: normally everything in it is kept and the configured capacity is applied by the caller,
+// but with keep_capacity gd's capacity stays as it is, so entries past it are dropped as they're decoded instead of all being held.
+// highscores_read counts every entry decoded, kept or not
+struct stored_game_data {
+	game_data & gd;
+	bool keep_capacity;
+	size_t highscores_read;
+};
 
 
 template <class Archive>
@@ -40,26 +88,423 @@ void serialize(Archive & archive, high_data & hd) {
 }
 
 template <class Archive>
-void serialize(Archive & archive, game_data & gd) {
-	archive(gd.name, gd.highscore);
+void save(Archive & archive, const game_data & gd) {
+	archive(gd.name, vector<high_data>(gd.highscore().begin(), gd.highscore().end()));
+}
+
+template <class Archive>
+void load(Archive & archive, stored_game_data & sgd) {
+	auto & gd = sgd.gd;
+	vector<high_data> highscore;
+	archive(gd.name, highscore);
+
+	if(!sgd.keep_capacity)
+		gd.highscore().capacity(max(gd.highscore().capacity(), highscore.size()));
+	sgd.highscores_read += highscore.size();
+	for(auto && hd : highscore)
+		gd.highscore().insert(move(hd));
+}
+
+
+// The player's name, then the highscores, best first, as columns: names dictionary-encoded,
+// scores as the first one followed by the (non-negative) differences to each next one, and levels; each integer column bit-packed.
+byte_buffer encode_game_data(const game_data & gd) {
+	const auto & highscore = gd.highscore();
+	byte_buffer res;
+	put_varint(res, gd.name.size());
+	res.insert(res.end(), gd.name.begin(), gd.name.end());
+	put_varint(res, highscore.size());
+
+	unordered_map<string, uint32_t> name_indices;
+	vector<const string *> names;
+	vector<uint32_t> name_column, score_column, level_column;
+	name_column.reserve(highscore.size());
+	score_column.reserve(highscore.size());
+	level_column.reserve(highscore.size());
+
+	auto previous_score = highscore.empty() ? 0 : highscore.begin()->score;
+	for(auto && hd : highscore) {
+		const auto index = name_indices.emplace(hd.name, names.size());
+		if(index.second)
+			names.emplace_back(&hd.name);
+		name_column.emplace_back(index.first->second);
+
+		score_column.emplace_back(previous_score - hd.score);
+		previous_score = hd.score;
+		level_column.emplace_back(hd.level);
+	}
+
+	put_varint(res, names.size());
+	for(auto name : names) {
+		put_varint(res, name->size());
+		res.insert(res.end(), name->begin(), name->end());
+	}
+	pack_column(name_column, res);
+	put_varint(res, highscore.empty() ? 0 : highscore.begin()->score);
+	pack_column(score_column, res);
+	pack_column(level_column, res);
+
+	return res;
+}
+
+static void load_columns(const byte_buffer & payload, stored_game_data & sgd) {
+	auto & gd       = sgd.gd;
+	const auto data = payload.data();
+	const auto size = payload.size();
+	size_t position = 0;
+
+	const auto get_string = [&]() {
+		const auto length = get_varint(data, size, position);
+		if(length > size - position)
+			throw simplesmart_exception("Corrupt highscore names");
+		string res(data + position, data + position + length);
+		position += length;
+		return res;
+	};
+
+	gd.name               = get_string();
+	const auto count      = get_varint(data, size, position);
+	const auto name_count = get_varint(data, size, position);
+	if(name_count > size - position)
+		throw simplesmart_exception("Corrupt highscore names");
+
+	vector<string> names;
+	names.reserve(name_count);
+	for(auto i = 0u; i < name_count; ++i)
+		names.emplace_back(get_string());
+
+	const auto name_column  = unpack_column(data, size, position, count);
+	auto score              = static_cast<uint32_t>(get_varint(data, size, position));
+	const auto score_column = unpack_column(data, size, position, count);
+	const auto level_column = unpack_column(data, size, position, count);
+
+	if(!sgd.keep_capacity)
+		gd.highscore().capacity(max(gd.highscore().capacity(), count));
+	sgd.highscores_read += count;
+	for(auto i = 0u; i < count; ++i) {
+		if(name_column[i] >= names.size() || score_column[i] > score || level_column[i] > numeric_limits<uint16_t>::max())
+			throw simplesmart_exception("Corrupt highscore columns");
+
+		score -= score_column[i];
+		gd.highscore().insert({names[name_column[i]], score, static_cast<uint16_t>(level_column[i])});
+	}
+}
+
+
+static byte_buffer load_compressed(istream & in) {
+	const auto method = saving_method_from_name(string(1, in.get()));
+	uint8_t size_bytes[4];
+	if(!method || !in.read(reinterpret_cast<char *>(size_bytes), sizeof(size_bytes)))
+		throw simplesmart_exception("Corrupt save header");
+	const auto original_size = size_bytes[0] | (size_bytes[1] << 8) | (size_bytes[2] << 16) | (static_cast<uint32_t>(size_bytes[3]) << 24);
+
+	const byte_buffer compressed{istreambuf_iterator<char>(in), istreambuf_iterator<char>()};
+	return decompress(*method, compressed.data(), compressed.size(), original_size);
+}
+
+template <class Archive>
+static void load_archive(istream & in, stored_game_data & sgd) {
+	Archive archive(in);
+	archive(sgd);
+}
+
+static string journal_filename(const string & filename) {
+	return filename + ".journal";
+}
+
+static uint16_t fletcher16(const uint8_t * data, size_t size) noexcept {
+	uint16_t lo = 0, hi = 0;
+	for(auto i = 0u; i < size; ++i) {
+		lo = (lo + data[i]) % 255;
+		hi = (hi + lo) % 255;
+	}
+	return (hi << 8) | lo;
+}
+
+static vector<high_data> read_journal(const string & filename) {
+	ifstream journal(journal_filename(filename), ios::binary);
+	uint8_t record[journal_record_size];
+	vector<high_data> recorded;
+	while(journal.read(reinterpret_cast<char *>(record), sizeof(record))) {
+		const auto check = fletcher16(record, journal_record_size - 2);
+		if(record[journal_record_size - 2] != (check & 0xFF) || record[journal_record_size - 1] != (check >> 8))
+			break;
+
+		const auto fields = record + game_data::max_name_length;
+		recorded.push_back({string(reinterpret_cast<const char *>(record), find(record, fields, 0) - record),
+		                    fields[0] | (fields[1] << 8) | (fields[2] << 16) | (static_cast<uint32_t>(fields[3]) << 24),
+		                    static_cast<uint16_t>(fields[4] | (fields[5] << 8))});
+	}
+	return recorded;
+}
+
+static void replay_journal(stored_game_data & sgd, const string & filename) {
+	auto & gd     = sgd.gd;
+	auto recorded = read_journal(filename);
+	if(!sgd.keep_capacity)
+		gd.highscore().capacity(max(gd.highscore().capacity(), gd.highscore().size() + recorded.size()));
+	sgd.highscores_read += recorded.size();
+	for(auto && hd : recorded)
+		gd.highscore().insert(move(hd));
+}
+
+// Reads the save into res and returns whether it's in an older format; throws if it's there but can't be read whole.
+// Legacy saves are always cut down to res's capacity as they're streamed in, others only with keep_capacity
+static bool read_snapshot(stored_game_data & res, istream & ifs, const string & filename) {
+	char magic[sizeof(save_magic)];
+	if(ifs.read(magic, sizeof(magic)) && equal(begin(magic), end(magic), begin(save_magic))) {
+		const auto version = ifs.get();
+		if(version == save_format_version) {
+			ifs.ignore(8);
+			load_columns(load_compressed(ifs), res);
+			return false;
+		} else if(version >= 1 && version <= 3) {
+			// Version 3 is rewritten only to get an index
+			if(version == 1)
+				load_archive<cereal::PortableBinaryInputArchive>(ifs, res);
+			else if(version == 2) {
+				const auto archived = load_compressed(ifs);
+				istringstream archive_stream(string(archived.begin(), archived.end()), ios::binary);
+				load_archive<cereal::PortableBinaryInputArchive>(archive_stream, res);
+			} else
+				load_columns(load_compressed(ifs), res);
+			return true;
+		} else
+			throw simplesmart_exception("Save from a newer version");
+	} else {
+		// Streamed rather than parsed whole, since legacy saves can be far bigger than the part of them that's kept
+		const auto report = import_legacy_save(filename, res.gd);
+		if(!report.error.empty())
+			throw simplesmart_exception("Corrupt legacy save at " + report.error);
+		res.highscores_read += report.highscores_read;
+		return true;
+	}
+}
+
+static bool move_file(const string & from, const string & to) {
+#ifdef _WIN32
+	return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+	return !rename(from.c_str(), to.c_str());
+#endif
+}
+
+static void load_snapshot(game_data & res, saving_method migrate_with, const string & filename) {
+	ifstream ifs(filename, ios::binary);
+	if(!ifs.is_open())
+		return;
+
+	try {
+		stored_game_data stored{res, false, 0};
+		if(read_snapshot(stored, ifs, filename)) {
+			ifs.close();
+			save_game_data_to_file(res, migrate_with, filename);
+		}
+		return;
+	} catch(cereal::Exception &) {
+	} catch(simplesmart_exception &) {
+	}
+
+	// A save that can't be read, from a newer format or otherwise, is moved out of the way rather than overwritten by the next one;
+	// the --import-legacy switch tells what's wrong with a legacy one
+	ifs.close();
+	if(!move_file(filename, filename + ".bak"))
+		throw simplesmart_exception("Couldn't read " + filename + " nor move it to " + filename + ".bak");
+}
+
+
+static string index_filename(const string & filename) {
+	const auto extension = filename.rfind(".dat");
+	return (extension != string::npos && extension == filename.size() - 4 ? filename.substr(0, extension) : filename) + ".idx";
+}
+
+// The serial of the save, without reading past its header; nullopt if it isn't a current-format one
+static optional<uint64_t> save_serial(const string & filename) {
+	ifstream ifs(filename, ios::binary);
+	uint8_t header[sizeof(save_magic) + 1 + 8];
+	if(!ifs.read(reinterpret_cast<char *>(header), sizeof(header)) || !equal(begin(save_magic), end(save_magic), header) ||
+	   header[sizeof(save_magic)] != save_format_version)
+		return nullopt;
+
+	uint64_t serial = 0;
+	for(auto i = 0u; i < 8; ++i)
+		serial |= static_cast<uint64_t>(header[sizeof(save_magic) + 1 + i]) << (i * 8);
+	return serial;
+}
+
+static shared_ptr<const highscore_index> open_index(const string & filename) {
+	const auto serial = save_serial(filename);
+	if(!serial)
+		return nullptr;
+	return highscore_index::open(index_filename(filename), *serial);
+}
+
+
+leaderboard & game_data::highscore() {
+	return const_cast<leaderboard &>(static_cast<const game_data &>(*this).highscore());
+}
+
+const leaderboard & game_data::highscore() const {
+	if(undecoded_highscore) {
+		for(auto i = 0u; i < undecoded_highscore->size(); ++i)
+			decoded_highscore.insert((*undecoded_highscore)[i]);
+		undecoded_highscore.reset();
+	}
+	return decoded_highscore;
 }
 
+void game_data::defer_highscore(shared_ptr<const indexed_highscores> highscores) {
+	undecoded_highscore = move(highscores);
+}
 
-game_data load_game_data_from_file(const std::string & filename) {
+const indexed_highscores * game_data::undecoded_highscores() const noexcept {
+	return undecoded_highscore.get();
+}
+
+optional<size_t> game_data::rank_of(uint32_t score) const {
+	const auto rank = undecoded_highscore ? undecoded_highscore->rank_of(score) : decoded_highscore.rank_of(score);
+	if(rank > decoded_highscore.capacity())
+		return nullopt;
+	return rank;
+}
+
+
+game_data load_game_data_from_file(saving_method migrate_with, size_t highscore_capacity, const std::string & filename) {
 	game_data res;
+	res.highscore().capacity(highscore_capacity);
+
+	// An index with more than fits is trimmed by decoding it all instead, which only happens after the capacity was lowered
+	auto index = open_index(filename);
+	if(index && index->size() <= highscore_capacity) {
+		res.name = index->player_name();
+		// Highscores recorded since the last save are only in the journal, which is bounded by compaction and so cheap to decode whole
+		res.defer_highscore(make_shared<const indexed_highscores>(move(index), read_journal(filename), highscore_capacity));
+		return res;
+	}
+
 	res.name = username();
+	load_snapshot(res, migrate_with, filename);
+	stored_game_data stored{res, false, 0};
+	replay_journal(stored, filename);
+	res.highscore().capacity(highscore_capacity);
 
+	return res;
+}
+
+game_data read_game_data_from_file(size_t highscore_capacity, const std::string & filename, size_t * highscores_read) {
+	ifstream ifs(filename, ios::binary);
+	if(!ifs.is_open())
+		throw simplesmart_exception("Couldn't open " + filename);
+
+	game_data res;
+	res.highscore().capacity(highscore_capacity);
+	stored_game_data stored{res, true, 0};
 	try {
-		ifstream ifs(filename);
-		cereal::JSONInputArchive archive(ifs);
-		archive(res);
-	} catch(cereal::RapidJSONException &) {}
+		read_snapshot(stored, ifs, filename);
+	} catch(cereal::Exception & exc) {
+		throw simplesmart_exception(exc.what());
+	}
+	replay_journal(stored, filename);
 
+	if(highscores_read)
+		*highscores_read = stored.highscores_read;
 	return res;
 }
 
-void save_game_data_to_file(const game_data & input_gd, const std::string & filename) {
-	ofstream ofs(filename);
-	cereal::JSONOutputArchive archive(ofs);
-	archive(input_gd);
+// Writes and flushes data all the way to the disk
+static bool write_durably(const string & filename, const char * mode, const uint8_t * data, size_t size) {
+	const auto file = fopen(filename.c_str(), mode);
+	if(!file)
+		return false;
+
+	auto written = fwrite(data, 1, size, file) == size && !fflush(file);
+#ifdef _WIN32
+	written = written && !_commit(_fileno(file));
+#else
+	written = written && !fsync(fileno(file));
+#endif
+	return !fclose(file) && written;
+}
+
+// Writes everything to the side and swaps it in only once it's on disk, so a crash mid-write leaves the old file whole
+static bool replace_durably(const string & filename, const byte_buffer & contents) {
+	const auto temporary_filename = filename + ".tmp";
+	if(!write_durably(temporary_filename, "wb", contents.data(), contents.size())) {
+		remove(temporary_filename.c_str());
+		return false;
+	}
+
+	return move_file(temporary_filename, filename);
+}
+
+bool save_game_data_to_file(const game_data & input_gd, saving_method method, const std::string & filename) {
+	const auto payload = encode_game_data(input_gd);
+	seed11::seed_device serial_source;
+	const auto serial = (static_cast<uint64_t>(serial_source()) << 32) ^ serial_source();
+
+	byte_buffer contents(begin(save_magic), end(save_magic));
+	contents.emplace_back(save_format_version);
+	for(auto i = 0u; i < 8; ++i)
+		contents.emplace_back((serial >> (i * 8)) & 0xFF);
+	contents.emplace_back(static_cast<uint8_t>(method));
+	for(auto i = 0u; i < 4; ++i)
+		contents.emplace_back((payload.size() >> (i * 8)) & 0xFF);
+	const auto compressed = compress(method, payload.data(), payload.size());
+	contents.insert(contents.end(), compressed.begin(), compressed.end());
+
+	if(!replace_durably(filename, contents))
+		return false;
+	// An index left over from an earlier save, or not replaced because it's still mapped on Windows, has a different serial and isn't used
+	replace_durably(index_filename(filename), highscore_index::encode(serial, input_gd.name, input_gd.highscore()));
+	return true;
+}
+
+static size_t file_size(const string & filename) {
+	ifstream file(filename, ios::binary | ios::ate);
+	return file.is_open() ? static_cast<size_t>(file.tellg()) : 0;
+}
+
+static bool truncate_file(const string & filename, size_t size) {
+#ifdef _WIN32
+	const auto file = _open(filename.c_str(), _O_WRONLY | _O_BINARY);
+	if(file == -1)
+		return false;
+	const auto truncated = !_chsize_s(file, size);
+	return !_close(file) && truncated;
+#else
+	return !truncate(filename.c_str(), size);
+#endif
+}
+
+bool append_to_journal(const high_data & hd, const std::string & filename) {
+	// What's left of a record torn by a failed append is cut off first, or this one and every later one would be read out of step
+	const auto length = file_size(journal_filename(filename));
+	if(length % journal_record_size && !truncate_file(journal_filename(filename), length - length % journal_record_size))
+		return false;
+
+	uint8_t record[journal_record_size]{};
+	copy_n(hd.name.begin(), min(hd.name.size(), game_data::max_name_length), record);
+
+	const auto fields = record + game_data::max_name_length;
+	for(auto i = 0u; i < 4; ++i)
+		fields[i] = (hd.score >> (i * 8)) & 0xFF;
+	fields[4] = hd.level & 0xFF;
+	fields[5] = hd.level >> 8;
+
+	const auto check                = fletcher16(record, journal_record_size - 2);
+	record[journal_record_size - 2] = check & 0xFF;
+	record[journal_record_size - 1] = check >> 8;
+
+	return write_durably(journal_filename(filename), "ab", record, sizeof(record));
+}
+
+size_t repair_journal(const std::string & filename) {
+	const auto records = read_journal(filename).size();
+	if(file_size(journal_filename(filename)) > records * journal_record_size)
+		truncate_file(journal_filename(filename), records * journal_record_size);
+	return records;
+}
+
+void clear_journal(const std::string & filename) {
+	remove(journal_filename(filename).c_str());
 }
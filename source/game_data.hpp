@@ -23,25 +23,56 @@
 #pragma once
 
 
-#include <vector>
 #include <string>
-#include <cstdint>
+#include <memory>
+#include <experimental/optional>
 
+#include "leaderboard.hpp"
+#include "highscore_index.hpp"
+#include "compression/compression.hpp"
 
-struct high_data {
-	std::string name;
-	uint32_t score;
-	uint16_t level;
-};
 
-struct game_data {
+class game_data {
+private:
+	mutable leaderboard decoded_highscore;
+	// Set while the highscores are still only in the save's index and journal
+	mutable std::shared_ptr<const indexed_highscores> undecoded_highscore;
+
+public:
 	static const constexpr std::size_t max_name_length = 40;
 
 
 	std::string name;
-	std::vector<high_data> highscore;
+
+	// Decodes the highscores still in the index on first use
+	leaderboard & highscore();
+	const leaderboard & highscore() const;
+	// Leaves the highscores in the index until they're needed whole
+	void defer_highscore(std::shared_ptr<const indexed_highscores> highscores);
+	// The index the highscores are still in, or nullptr once they've been decoded
+	const indexed_highscores * undecoded_highscores() const noexcept;
+	// The 1-based rank a score would take, if it'd make the board at all; doesn't decode anything
+	std::experimental::optional<std::size_t> rank_of(std::uint32_t score) const;
 };
 
 
-game_data load_game_data_from_file(const std::string & filename = "gd.dat");
-void save_game_data_to_file(const game_data & input_gd, const std::string & filename = "gd.dat");
+// Saves in an older format are rewritten straight away, compressed with migrate_with.
+// One that can't be read is moved to filename.bak, so saving over it can't lose it; simplesmart_exception is thrown if even that fails.
+// If the index beside the save is up to date, the highscores are left in it, with the journal's laid over it.
+game_data load_game_data_from_file(saving_method migrate_with = saving_method::fast_lz, std::size_t highscore_capacity = leaderboard::default_capacity,
+                                   const std::string & filename = "gd.dat");
+// Reads a save, and its journal, without rewriting it whatever its format; throws simplesmart_exception if it can't be read whole.
+// Only the best highscore_capacity highscores are ever held, the rest are dropped as they're decoded; highscores_read gets how many there were
+game_data read_game_data_from_file(std::size_t highscore_capacity, const std::string & filename, std::size_t * highscores_read = nullptr);
+// The uncompressed payload of a save, as its saving method gets it
+byte_buffer encode_game_data(const game_data & gd);
+// Also rewrites the index beside the save; returns whether the save made it to the disk, the old one is left whole if not
+bool save_game_data_to_file(const game_data & input_gd, saving_method method = saving_method::fast_lz, const std::string & filename = "gd.dat");
+
+// The journal beside the save takes single highscores for O(1) I/O each, and is replayed on top of the save when it's loaded;
+// appending returns whether the record made it to the disk
+bool append_to_journal(const high_data & hd, const std::string & filename = "gd.dat");
+// Cuts the journal back to before its first torn or corrupt record, which replaying stops at anyway, and returns how many records are left
+std::size_t repair_journal(const std::string & filename = "gd.dat");
+// Only safe once everything in the journal is in the save
+void clear_journal(const std::string & filename = "gd.dat");
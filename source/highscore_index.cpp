@@ -0,0 +1,244 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "highscore_index.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "exceptions.hpp"
+
+
+using namespace std;
+
+
+static const constexpr char index_magic[]                 = {'a', 'S', 'S', 'i', 'x'};
+static const constexpr unsigned char index_format_version = 1;
+static const constexpr size_t header_size                 = sizeof(index_magic) + 1 + 2 + 8 + 4 + 4;
+static const constexpr size_t record_size                 = 4 + 4 + 2 + 2;
+
+
+static uint64_t get_le(const uint8_t * data, size_t bytes) noexcept {
+	uint64_t res = 0;
+	for(auto i = 0u; i < bytes; ++i)
+		res |= static_cast<uint64_t>(data[i]) << (i * 8);
+	return res;
+}
+
+static void put_le(vector<uint8_t> & into, uint64_t value, size_t bytes) {
+	for(auto i = 0u; i < bytes; ++i)
+		into.emplace_back((value >> (i * 8)) & 0xFF);
+}
+
+
+highscore_index::highscore_index(const uint8_t * pdata, size_t pdata_size)
+      : data(pdata), data_size(pdata_size), entries(get_le(data + 16, 4)), names_offset(header_size + get_le(data + 20, 4) + entries * record_size) {}
+
+unique_ptr<const highscore_index> highscore_index::open(const string & filename, uint64_t serial) {
+#ifdef _WIN32
+	const auto file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER file_size;
+	if(!GetFileSizeEx(file, &file_size) || static_cast<unsigned long long>(file_size.QuadPart) < header_size) {
+		CloseHandle(file);
+		return nullptr;
+	}
+	const auto size = static_cast<size_t>(file_size.QuadPart);
+
+	// The view keeps the mapping and the file open on its own
+	const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if(!mapping)
+		return nullptr;
+	const auto mapped = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if(!mapped)
+		return nullptr;
+#else
+	const auto file = ::open(filename.c_str(), O_RDONLY);
+	if(file == -1)
+		return nullptr;
+
+	struct stat file_stat;
+	if(fstat(file, &file_stat) || static_cast<unsigned long long>(file_stat.st_size) < header_size) {
+		close(file);
+		return nullptr;
+	}
+	const auto size = static_cast<size_t>(file_stat.st_size);
+
+	// The mapping keeps the file open on its own
+	auto mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if(mapped == MAP_FAILED)
+		return nullptr;
+#endif
+
+	unique_ptr<const highscore_index> res(new highscore_index(static_cast<const uint8_t *>(mapped), size));
+	const auto name_size = get_le(res->data + 20, 4);
+	if(!equal(begin(index_magic), end(index_magic), res->data) || res->data[sizeof(index_magic)] != index_format_version || get_le(res->data + 8, 8) != serial ||
+	   name_size > size - header_size || (size - header_size - name_size) / record_size < res->entries)
+		return nullptr;
+	return res;
+}
+
+vector<uint8_t> highscore_index::encode(uint64_t serial, const string & player_name, const leaderboard & highscores) {
+	vector<uint8_t> res(begin(index_magic), end(index_magic));
+	res.emplace_back(index_format_version);
+	put_le(res, 0, 2);
+	put_le(res, serial, 8);
+	put_le(res, highscores.size(), 4);
+	put_le(res, player_name.size(), 4);
+	res.insert(res.end(), player_name.begin(), player_name.end());
+
+	// Names are stored once however many entries share them
+	unordered_map<string, uint32_t> name_offsets;
+	string names;
+	res.reserve(res.size() + highscores.size() * record_size);
+	for(auto && hd : highscores) {
+		const auto offset = name_offsets.emplace(hd.name, names.size());
+		if(offset.second)
+			names += hd.name;
+
+		put_le(res, hd.score, 4);
+		put_le(res, offset.first->second, 4);
+		put_le(res, hd.name.size(), 2);
+		put_le(res, hd.level, 2);
+	}
+	res.insert(res.end(), names.begin(), names.end());
+
+	return res;
+}
+
+highscore_index::~highscore_index() {
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+#else
+	munmap(const_cast<uint8_t *>(data), data_size);
+#endif
+}
+
+uint32_t highscore_index::score_at(size_t position) const noexcept {
+	return get_le(data + names_offset - (entries - position) * record_size, 4);
+}
+
+string highscore_index::player_name() const {
+	return {data + header_size, data + header_size + get_le(data + 20, 4)};
+}
+
+size_t highscore_index::size() const noexcept {
+	return entries;
+}
+
+bool highscore_index::empty() const noexcept {
+	return !entries;
+}
+
+high_data highscore_index::operator[](size_t position) const {
+	const auto record      = data + names_offset - (entries - position) * record_size;
+	const auto name_offset = get_le(record + 4, 4);
+	const auto name_size   = get_le(record + 8, 2);
+	if(name_offset > data_size - names_offset || name_size > data_size - names_offset - name_offset)
+		throw simplesmart_exception("Corrupt highscore index");
+
+	return {{data + names_offset + name_offset, data + names_offset + name_offset + name_size},
+	        static_cast<uint32_t>(get_le(record, 4)),
+	        static_cast<uint16_t>(get_le(record + 10, 2))};
+}
+
+size_t highscore_index::rank_of(uint32_t score) const noexcept {
+	size_t low = 0, high = entries;
+	while(low < high) {
+		const auto middle = low + (high - low) / 2;
+		if(score_at(middle) > score)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low + 1;
+}
+
+size_t highscore_index::position_of(const high_data & entry) const {
+	size_t low = 0, high = entries;
+	while(low < high) {
+		const auto middle = low + (high - low) / 2;
+		if(leaderboard::better{}((*this)[middle], entry))
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low;
+}
+
+
+indexed_highscores::indexed_highscores(shared_ptr<const highscore_index> pindex, vector<high_data> pjournalled, size_t capacity) : index(move(pindex)) {
+	sort(pjournalled.begin(), pjournalled.end(), leaderboard::better{});
+	for(auto && entry : pjournalled) {
+		if(!journalled.empty() && !leaderboard::better{}(journalled.back(), entry))
+			continue;
+
+		// An entry journalled before the save it went into is already in the index
+		const auto position = index->position_of(entry);
+		if(position < index->size()) {
+			const auto there = (*index)[position];
+			if(there.score == entry.score && there.level == entry.level && there.name == entry.name)
+				continue;
+		}
+
+		journalled_positions.emplace_back(position + journalled.size());
+		journalled.emplace_back(move(entry));
+	}
+
+	entries = min(index->size() + journalled.size(), capacity);
+}
+
+size_t indexed_highscores::size() const noexcept {
+	return entries;
+}
+
+bool indexed_highscores::empty() const noexcept {
+	return !entries;
+}
+
+high_data indexed_highscores::operator[](size_t position) const {
+	const auto before = upper_bound(journalled_positions.begin(), journalled_positions.end(), position) - journalled_positions.begin();
+	if(before && journalled_positions[before - 1] == position)
+		return journalled[before - 1];
+	return (*index)[position - before];
+}
+
+size_t indexed_highscores::rank_of(uint32_t score) const noexcept {
+	const auto higher_journalled =
+	    partition_point(journalled.begin(), journalled.end(), [&](const high_data & entry) { return entry.score > score; }) - journalled.begin();
+	return index->rank_of(score) + higher_journalled;
+}
@@ -0,0 +1,90 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "leaderboard.hpp"
+
+
+// A read-only view of the highscores as saved in the fixed-layout index beside a save, mapped into memory;
+// entries are only decoded as they're asked for, so opening one costs the same however many scores it holds.
+//
+// The index starts with the magic, a format version byte, two reserved bytes, the save's serial as 64-bit, and the entry and player name byte counts
+// as 32-bit, all little-endian, followed by the player's name, then fixed-size records, best first, of the score, the name's offset into the names
+// region as 32-bit, the name's size and the level as 16-bit, and finally the names region itself.
+class highscore_index {
+private:
+	const std::uint8_t * data;
+	std::size_t data_size;
+	std::size_t entries;
+	std::size_t names_offset;
+
+	highscore_index(const std::uint8_t * data, std::size_t data_size);
+
+	std::uint32_t score_at(std::size_t position) const noexcept;
+
+public:
+	// Null if the index is missing, malformed, or was written for a different save than the one with this serial
+	static std::unique_ptr<const highscore_index> open(const std::string & filename, std::uint64_t serial);
+	static std::vector<std::uint8_t> encode(std::uint64_t serial, const std::string & player_name, const leaderboard & highscores);
+
+	highscore_index(const highscore_index &) = delete;
+	highscore_index & operator=(const highscore_index &) = delete;
+	~highscore_index();
+
+	std::string player_name() const;
+	std::size_t size() const noexcept;
+	bool empty() const noexcept;
+	// The entry at the 0-based position, decoded from the mapping
+	high_data operator[](std::size_t position) const;
+	// The 1-based rank a score would take, one more than the number of higher scores; a binary search over the records alone
+	std::size_t rank_of(std::uint32_t score) const noexcept;
+	// The 0-based position an entry would take, the number of better entries; decodes the O(log n) entries it's compared against
+	std::size_t position_of(const high_data & entry) const;
+};
+
+// An index with the highscores journalled since its save laid over it, as one best-first list of at most capacity entries.
+// The journal is small, so its entries are decoded up front, and the index's still only as they're asked for.
+class indexed_highscores {
+private:
+	std::shared_ptr<const highscore_index> index;
+	// Journalled entries not already in the index, best first, and the positions they take in the whole list
+	std::vector<high_data> journalled;
+	std::vector<std::size_t> journalled_positions;
+	std::size_t entries;
+
+public:
+	indexed_highscores(std::shared_ptr<const highscore_index> index, std::vector<high_data> journalled, std::size_t capacity);
+
+	std::size_t size() const noexcept;
+	bool empty() const noexcept;
+	high_data operator[](std::size_t position) const;
+	// The 1-based rank a score would take, one more than the number of higher scores
+	std::size_t rank_of(std::uint32_t score) const noexcept;
+};
@@ -0,0 +1,111 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "leaderboard.hpp"
+
+#include <tuple>
+#include <limits>
+#include <utility>
+#include <iterator>
+
+
+using namespace std;
+
+
+bool leaderboard::better::operator()(const high_data & lhs, const high_data & rhs) const noexcept {
+	return tie(rhs.score, rhs.level, lhs.name) < tie(lhs.score, lhs.level, rhs.name);
+}
+
+
+leaderboard::leaderboard(size_t capacity) : max_entries(capacity) {}
+
+void leaderboard::drop_worst() {
+	const auto worst = prev(entries.end());
+	const auto level = by_level.find(worst->level);
+	level->second.erase(*worst);
+	if(level->second.empty())
+		by_level.erase(level);
+	entries.erase(worst);
+}
+
+bool leaderboard::insert(high_data entry) {
+	if(entries.size() >= max_entries && (!max_entries || !better{}(entry, *entries.rbegin())))
+		return false;
+
+	if(!entries.insert(entry).second)
+		return false;
+	by_level[entry.level].insert(move(entry));
+	if(entries.size() > max_entries)
+		drop_worst();
+	return true;
+}
+
+void leaderboard::capacity(size_t new_capacity) {
+	max_entries = new_capacity;
+	while(entries.size() > max_entries)
+		drop_worst();
+}
+
+size_t leaderboard::capacity() const noexcept {
+	return max_entries;
+}
+
+size_t leaderboard::size() const noexcept {
+	return entries.size();
+}
+
+bool leaderboard::empty() const noexcept {
+	return entries.empty();
+}
+
+leaderboard::const_iterator leaderboard::begin() const noexcept {
+	return entries.begin();
+}
+
+leaderboard::const_iterator leaderboard::end() const noexcept {
+	return entries.end();
+}
+
+leaderboard::const_iterator leaderboard::find_by_rank(size_t position) const {
+	return entries.find_by_order(position);
+}
+
+// The first entry in the ordering with this score is the one with the highest level and the smallest name
+size_t leaderboard::rank_of(uint32_t score) const {
+	return entries.order_of_key(high_data{{}, score, numeric_limits<uint16_t>::max()}) + 1;
+}
+
+size_t leaderboard::rank_of(uint32_t score, uint16_t level) const {
+	const auto entries_on_level = by_level.find(level);
+	if(entries_on_level == by_level.end())
+		return 1;
+	return entries_on_level->second.order_of_key(high_data{{}, score, level}) + 1;
+}
+
+vector<high_data> leaderboard::top(uint16_t level, size_t count) const {
+	vector<high_data> res;
+	const auto entries_on_level = by_level.find(level);
+	if(entries_on_level != by_level.end())
+		for(auto entry = entries_on_level->second.begin(); entry != entries_on_level->second.end() && res.size() < count; ++entry)
+			res.emplace_back(*entry);
+	return res;
+}
@@ -0,0 +1,89 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <ext/pb_ds/assoc_container.hpp>
+#include <ext/pb_ds/tree_policy.hpp>
+
+
+struct high_data {
+	std::string name;
+	uint32_t score;
+	uint16_t level;
+};
+
+
+// Highscores kept best-first, without duplicate entries, and capped at capacity() entries.
+//
+// Entries are ordered by score, then level, both descending, then name; inserting is O(log n).
+// Entries are also indexed per level in order-statistic trees, so ranks and per-level top lists are O(log n) too.
+class leaderboard {
+public:
+	// The order entries are kept in; entries are duplicates if neither is better than the other
+	struct better {
+		bool operator()(const high_data & lhs, const high_data & rhs) const noexcept;
+	};
+
+private:
+	using ordered_entries =
+	    __gnu_pbds::tree<high_data, __gnu_pbds::null_type, better, __gnu_pbds::rb_tree_tag, __gnu_pbds::tree_order_statistics_node_update>;
+
+	ordered_entries entries;
+	std::map<std::uint16_t, ordered_entries> by_level;
+	std::size_t max_entries;
+
+	void drop_worst();
+
+public:
+	using const_iterator = ordered_entries::const_iterator;
+
+	static const constexpr std::size_t default_capacity = 100;
+
+
+	leaderboard(std::size_t capacity = default_capacity);
+
+	// Returns whether the entry made it onto the board
+	bool insert(high_data entry);
+	// Drops the worst entries if there are more than the new capacity
+	void capacity(std::size_t new_capacity);
+	std::size_t capacity() const noexcept;
+
+	std::size_t size() const noexcept;
+	bool empty() const noexcept;
+	const_iterator begin() const noexcept;
+	const_iterator end() const noexcept;
+
+	// The entry at the 0-based position, or end() if there are fewer entries
+	const_iterator find_by_rank(std::size_t position) const;
+	// The 1-based rank a score would take, one more than the number of higher scores; overall, or among those on a level
+	std::size_t rank_of(std::uint32_t score) const;
+	std::size_t rank_of(std::uint32_t score, std::uint16_t level) const;
+	// The best entries on a level, at most count of them
+	std::vector<high_data> top(std::uint16_t level, std::size_t count) const;
+};
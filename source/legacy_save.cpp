@@ -0,0 +1,187 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "legacy_save.hpp"
+
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+
+#include "cereal/external/rapidjson/reader.h"
+#include "cereal/external/rapidjson/filereadstream.h"
+#include "cereal/external/rapidjson/error/en.h"
+
+
+using namespace std;
+namespace json = CEREAL_RAPIDJSON_NAMESPACE;
+
+
+// cereal writes every unnamed value as value0, value1, ... in order, so a legacy save is laid out as
+// {"value0": {"value0": name, "value1": [{"value0": name, "value1": score, "value2": level}, ...]}};
+// like cereal, members are told apart by position, not key.
+class legacy_save_handler : public json::BaseReaderHandler<json::UTF8<>, legacy_save_handler> {
+private:
+	static const constexpr size_t root_depth  = 1;
+	static const constexpr size_t data_depth  = 2;
+	static const constexpr size_t list_depth  = 3;
+	static const constexpr size_t entry_depth = 4;
+
+	game_data & gd;
+	size_t depth;
+	// How many members of the objects being read have been started, by depth
+	size_t members[entry_depth + 1];
+	high_data entry;
+
+	bool at(size_t in_depth, size_t member) const noexcept {
+		return depth == in_depth && members[depth] == member + 1;
+	}
+
+	bool fail(const char * why) {
+		error = why;
+		return false;
+	}
+
+	bool number(uint64_t value) {
+		if(at(entry_depth, 1)) {
+			if(value > numeric_limits<uint32_t>::max())
+				return fail("score out of range");
+			entry.score = value;
+		} else if(at(entry_depth, 2)) {
+			if(value > numeric_limits<uint16_t>::max())
+				return fail("level out of range");
+			entry.level = value;
+		} else
+			return fail("unexpected number");
+		return true;
+	}
+
+public:
+	size_t highscores_read;
+	string error;
+
+
+	legacy_save_handler(game_data & pgd) : gd(pgd), depth(0), members{}, highscores_read(0) {}
+
+	bool Default() {
+		return fail("unexpected value");
+	}
+
+	bool Int(int value) {
+		return value < 0 ? fail("negative number") : number(value);
+	}
+
+	bool Uint(unsigned int value) {
+		return number(value);
+	}
+
+	bool Int64(int64_t value) {
+		return value < 0 ? fail("negative number") : number(value);
+	}
+
+	bool Uint64(uint64_t value) {
+		return number(value);
+	}
+
+	bool String(const char * value, json::SizeType length, bool) {
+		// Names can't be longer in-game, so they're cut there instead of being kept whole however long
+		const auto kept = min<size_t>(length, game_data::max_name_length);
+		if(at(data_depth, 0))
+			gd.name.assign(value, kept);
+		else if(at(entry_depth, 0))
+			entry.name.assign(value, kept);
+		else
+			return fail("unexpected string");
+		return true;
+	}
+
+	bool Key(const char *, json::SizeType, bool) {
+		++members[depth];
+		return true;
+	}
+
+	bool StartObject() {
+		if(!(depth == 0 || at(root_depth, 0) || depth == list_depth))
+			return fail("unexpected object");
+
+		members[++depth] = 0;
+		if(depth == entry_depth)
+			entry = {};
+		return true;
+	}
+
+	bool EndObject(json::SizeType) {
+		if(depth == entry_depth) {
+			if(members[depth] != 3)
+				return fail("highscore without a name, score, and level");
+			gd.highscore().insert(move(entry));
+			++highscores_read;
+		}
+		--depth;
+		return true;
+	}
+
+	bool StartArray() {
+		if(!at(data_depth, 1))
+			return fail("unexpected array");
+		++depth;
+		return true;
+	}
+
+	bool EndArray(json::SizeType) {
+		--depth;
+		return true;
+	}
+};
+
+
+legacy_import_report import_legacy_save(const string & filename, game_data & gd) {
+	const auto start = chrono::steady_clock::now();
+	legacy_import_report res{};
+
+	unique_ptr<FILE, int (*)(FILE *)> file(fopen(filename.c_str(), "rb"), fclose);
+	if(!file) {
+		res.error = "couldn't open " + filename;
+		return res;
+	}
+
+	// The whole file only ever goes through this buffer, and strings through the reader's stack
+	vector<char> buffer(64 * 1024);
+	json::FileReadStream stream(file.get(), buffer.data(), buffer.size());
+	legacy_save_handler handler(gd);
+	json::Reader reader;
+	const auto result = reader.Parse<json::kParseDefaultFlags>(stream, handler);
+
+	res.bytes_read      = stream.Tell();
+	res.highscores_read = handler.highscores_read;
+	res.seconds         = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	if(result.IsError()) {
+		res.error = "byte " + to_string(result.Offset()) + ": " +
+		            (result.Code() == json::kParseErrorTermination ? handler.error : string(json::GetParseError_En(result.Code())));
+		// RapidJSON's messages end with a full stop, the handler's don't
+		if(res.error.back() == '.')
+			res.error.pop_back();
+	}
+	return res;
+}
@@ -0,0 +1,44 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <string>
+#include <cstddef>
+
+#include "game_data.hpp"
+
+
+// How far importing a legacy save got, and how quickly
+struct legacy_import_report {
+	std::size_t bytes_read;
+	std::size_t highscores_read;
+	double seconds;
+	// Empty if the whole save was read, otherwise where and why it stopped
+	std::string error;
+};
+
+
+// Streams a JSON save, as written before the binary format, straight into gd; memory use is bounded by gd's highscore capacity, not the file's size.
+// Whatever was read before an error is kept.
+legacy_import_report import_legacy_save(const std::string & filename, game_data & gd);
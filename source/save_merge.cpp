@@ -0,0 +1,111 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "save_merge.hpp"
+
+#include <queue>
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <exception>
+
+#include "game_data.hpp"
+#include "rust_helpers.hpp"
+
+
+using namespace std;
+
+
+merge_report merge_saves(vector<string> inputs, size_t top, saving_method method, const string & output) {
+	const auto start = chrono::steady_clock::now();
+	merge_report res{};
+
+	// A save already at output, with its journal, is merged in rather than replaced, since that journal's cleared once the merge is written
+	if(find(inputs.begin(), inputs.end(), output) == inputs.end() && ifstream(output, ios::binary).is_open())
+		inputs.emplace_back(output);
+	res.saves_read = inputs.size();
+
+	// Each input is claimed by exactly one worker, so its slots are only ever touched by that one
+	vector<vector<high_data>> decoded(inputs.size());
+	vector<size_t> read(inputs.size());
+	vector<string> errors(inputs.size());
+	atomic<size_t> next_input(0);
+	const auto decode = [&]() {
+		for(size_t i; (i = next_input++) < inputs.size();)
+			try {
+				const auto gd = read_game_data_from_file(top, inputs[i], &read[i]);
+				decoded[i].assign(gd.highscore().begin(), gd.highscore().end());
+			} catch(const exception & exc) {
+				errors[i] = inputs[i] + ": " + exc.what();
+			}
+	};
+
+	vector<thread> workers(min<size_t>(max(thread::hardware_concurrency(), 1u), inputs.size()));
+	for(auto && worker : workers)
+		worker = thread(decode);
+	for(auto && worker : workers)
+		worker.join();
+
+	for(auto && error : errors)
+		if(!error.empty())
+			res.errors.emplace_back(move(error));
+	for(auto && count : read)
+		res.highscores_read += count;
+
+	if(res.errors.empty()) {
+		// Every input is already best-first, so the heap holds the next entry of each, and duplicates come out next to each other
+		using cursor = pair<vector<high_data>::const_iterator, vector<high_data>::const_iterator>;
+		const auto worse = [](const cursor & lhs, const cursor & rhs) { return leaderboard::better{}(*rhs.first, *lhs.first); };
+		priority_queue<cursor, vector<cursor>, decltype(worse)> heads(worse);
+		for(auto && highscores : decoded)
+			if(!highscores.empty())
+				heads.emplace(highscores.begin(), highscores.end());
+
+		game_data merged;
+		merged.name = username();
+		merged.highscore().capacity(top);
+		const high_data * last = nullptr;
+		while(!heads.empty() && merged.highscore().size() < top) {
+			auto head = heads.top();
+			heads.pop();
+			if(!last || leaderboard::better{}(*last, *head.first)) {
+				merged.highscore().insert(*head.first);
+				last = &*head.first;
+			}
+			if(++head.first != head.second)
+				heads.emplace(head);
+		}
+
+		res.highscores_kept = merged.highscore().size();
+		// The journal at output was read in with its save, so it's all in the merge
+		if(save_game_data_to_file(merged, method, output))
+			clear_journal(output);
+		else
+			res.errors.emplace_back(output + ": couldn't write the merged save");
+	}
+
+	res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return res;
+}
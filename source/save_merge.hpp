@@ -0,0 +1,48 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "compression/compression.hpp"
+
+
+// How merging saves went
+struct merge_report {
+	std::size_t saves_read;
+	std::size_t highscores_read;  // Before each input was cut down to the top ones
+	std::size_t highscores_kept;
+	double seconds;
+	// What went wrong with each input that couldn't be read, or with writing the output, if anything; nothing's written unless all inputs could be read
+	std::vector<std::string> errors;
+};
+
+
+// Combines the best top highscores of all the inputs, binary or legacy JSON, without duplicates, into a new save at output.
+// A save already at output is one of the inputs, along with its journal, so nothing recorded there is lost to the merge.
+// Inputs are decoded on as many threads as there are cores and each cut down to its top best, legacy ones while they're streamed in;
+// only then are they k-way merged, so what's held is top entries per input, plus the packed columns of one binary input per thread being decoded.
+merge_report merge_saves(std::vector<std::string> inputs, std::size_t top, saving_method method, const std::string & output);
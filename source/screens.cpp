@@ -0,0 +1,463 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "screens.hpp"
+
+#include <limits>
+#include <algorithm>
+
+#include <tui.h>
+
+#include "board_view.hpp"
+
+
+using namespace std;
+
+
+static void draw_menu_button(WINDOW * menu_button_window) {
+	wborder(menu_button_window, ACS_VLINE, ACS_VLINE, ACS_HLINE, ACS_HLINE, ACS_ULCORNER, ACS_URCORNER, ACS_LLCORNER, ACS_LRCORNER);
+	mvwaddstr(menu_button_window, 1, 1, "Menu");
+	mvwchgat(menu_button_window, 1, 1, 1, A_BOLD, 0, nullptr);
+}
+
+static void wait_for_menu(WINDOW * window) {
+	raw();
+	nonl();
+	cbreak();
+
+	while(true) {
+		const auto pressed = wgetch(window);
+		if(pressed == 'm' || pressed == 'M' || pressed == CARRIAGE_RETURN)
+			break;
+	}
+}
+
+
+retained_screen::retained_screen(WINDOW * pparent_window) : built_width(-1), built_height(-1), parent_window(pparent_window) {
+	getmaxyx(parent_window, configured_height, configured_width);
+}
+
+retained_screen::~retained_screen() {
+	children.clear();
+}
+
+WINDOW * retained_screen::child(int lines, int cols, int begin_y, int begin_x) {
+	children.emplace_back(derwin(window.get(), lines, cols, begin_y, begin_x));
+	return children.back().get();
+}
+
+void retained_screen::show() {
+	// curses only ever shrinks the parent to fit a smaller terminal, so it's fitted here, growing back up to its configured size
+	int maxX, maxY, begX, begY, terminalX, terminalY;
+	getbegyx(parent_window, begY, begX);
+	getmaxyx(stdscr, terminalY, terminalX);
+	maxX = max(min(configured_width, terminalX - begX), 1);
+	maxY = max(min(configured_height, terminalY - begY), 1);
+	wresize(parent_window, maxY, maxX);
+
+	if(!window || maxX != built_width || maxY != built_height) {
+		children.clear();
+		window.reset(newwin(maxY, maxX, begY, begX));
+		build(maxY, maxX);
+		built_width  = maxX;
+		built_height = maxY;
+	}
+
+	touchwin(window.get());
+	wnoutrefresh(window.get());
+}
+
+
+mainscreen::mainscreen(WINDOW * pparent_window, bool pput_apo_in) : retained_screen(pparent_window), put_apo_in(pput_apo_in) {}
+
+void mainscreen::build(int maxY, int maxX) {
+	const auto start_button_window = child(3, 7, 0, (maxX - 7) / 2);
+	int tempX, tempY;
+	getparyx(start_button_window, tempY, tempX);
+	const auto tutorial_button_window = child(3, 10, tempY + 3, (maxX - 10) / 2);
+	const auto quit_button_window     = child(3, 6, maxY - 3, maxX - 6);
+	const auto credits_button_window  = child(3, 9, maxY - 3, 0);
+	const auto options_button_window  = child(3, 9, maxY - 3, (maxX - 9) / 2);
+	getparyx(options_button_window, tempY, tempX);
+	const auto highscore_button_window  = child(3, 10, tempY - 3, (maxX - 11) / 2);
+	const auto bigstring_message_window = child(8, 51, (maxY - 8) / 2, (maxX - 51) / 2);
+
+#define FOR_ALL_WINDOWS_ARG(func, ...)       \
+	func(start_button_window, __VA_ARGS__);    \
+	func(tutorial_button_window, __VA_ARGS__); \
+	func(quit_button_window, __VA_ARGS__);     \
+	func(credits_button_window, __VA_ARGS__);  \
+	func(options_button_window, __VA_ARGS__);  \
+	func(highscore_button_window, __VA_ARGS__);
+
+	FOR_ALL_WINDOWS_ARG(wborder, ACS_VLINE, ACS_VLINE, ACS_HLINE, ACS_HLINE, ACS_ULCORNER, ACS_URCORNER, ACS_LLCORNER, ACS_LRCORNER)
+	mvwaddstr(start_button_window, 1, 1, "Start");
+	mvwaddstr(tutorial_button_window, 1, 1, "Tutorial");
+	mvwaddstr(quit_button_window, 1, 1, "Quit");
+	mvwaddstr(credits_button_window, 1, 1, "Credits");
+	mvwaddstr(options_button_window, 1, 1, "Options");
+	mvwaddstr(highscore_button_window, 1, 1, "Higscore");
+	FOR_ALL_WINDOWS_ARG(mvwchgat, 1, 1, 1, A_BOLD, 0, nullptr);
+
+#undef FOR_ALL_WINDOWS_ARG
+
+	if(put_apo_in) {
+		mvwaddstr(bigstring_message_window, 0, 0, R"(  __    __        __     __   ___________          )");
+		mvwaddstr(bigstring_message_window, 1, 0, R"(//  \\//  \\/  \//  \\ //  \\|__   _____ \    _    )");
+		mvwaddstr(bigstring_message_window, 2, 0, R"(||    ||  |||  |||  || ||  ||   \ /     \| __| |__ )");
+		mvwaddstr(bigstring_message_window, 3, 0, R"(\\__  \\__//\_ |\\__// \\__//   | |       |__   __|)");
+		mvwaddstr(bigstring_message_window, 4, 0, R"(    \\  //\\   |/\\  //@@\\/    | |          | |   )");
+		mvwaddstr(bigstring_message_window, 5, 0, R"(    || //  \\ /|  \\ ||  |||    | |          | |   )");
+		mvwaddstr(bigstring_message_window, 6, 0, R"(\\__////    \|/    \\\\__//\_   |_|          \_\   )");
+		mvwaddstr(bigstring_message_window, 4, 23, "\304\304");
+	} else {
+		mvwaddstr(bigstring_message_window, 0, 0, R"(  __                          ___________          )");
+		mvwaddstr(bigstring_message_window, 1, 0, R"(//  \\                       |__   _____ \    _    )");
+		mvwaddstr(bigstring_message_window, 2, 0, R"(||                              \ /     \| __| |__ )");
+		mvwaddstr(bigstring_message_window, 3, 0, R"(\\__                   __       | |       |__   __|)");
+		mvwaddstr(bigstring_message_window, 4, 0, R"(    \\  //\\   //\\  //  \\/    | |          | |   )");
+		mvwaddstr(bigstring_message_window, 5, 0, R"(    || //  \\ //  \\ ||  |||    | |          | |   )");
+		mvwaddstr(bigstring_message_window, 6, 0, R"(\\__////    \|/    \\\\__//\_   |_|          \_\   )");
+	}
+}
+
+mainscreen_selection mainscreen::choose() {
+	show();
+	doupdate();
+
+	raw();
+	nonl();
+	cbreak();
+	mainscreen_selection toret = static_cast<mainscreen_selection>(-1);
+	while(toret == static_cast<mainscreen_selection>(-1)) {
+		switch(wgetch(window.get())) {
+			case 's':
+			case 'S':
+				toret = mainscreen_selection::start;
+				break;
+			case 't':
+			case 'T':
+				toret = mainscreen_selection::tutorial;
+				break;
+			case 'q':
+			case 'Q':
+				toret = mainscreen_selection::quit;
+				break;
+			case 'c':
+			case 'C':
+				toret = mainscreen_selection::credits;
+				break;
+			case 'o':
+			case 'O':
+				toret = mainscreen_selection::options;
+				break;
+			case 'h':
+			case 'H':
+				toret = mainscreen_selection::highscore;
+				break;
+			case KEY_RESIZE:
+				show();
+				doupdate();
+				break;
+		}
+	}
+
+	return toret;
+}
+
+
+creditsscreen::creditsscreen(WINDOW * pparent_window, bool pput_apo_in) : retained_screen(pparent_window), put_apo_in(pput_apo_in) {}
+
+void creditsscreen::build(int maxY, int maxX) {
+	const auto menu_button_window           = child(3, 6, maxY - 3, maxX - 6);
+	const auto bigstring_message_window     = child(8, 42, (maxY - 8) / 2, (maxX - 42) / 2);
+	const auto credit_apo_message_window    = child(3, 35, 0, (maxX - 35) / 2);
+	const auto credit_me_message_window     = child(3, 48, maxY - 3, (maxX - 48) / 2);
+	const auto credit_cereal_message_window = child(3, 31, 3, (maxX - 31) / 2);
+
+	draw_menu_button(menu_button_window);
+
+	if(put_apo_in) {
+		mvwaddstr(bigstring_message_window, 0, 0, R"(  __   _   __       __           //@@\\   )");
+		mvwaddstr(bigstring_message_window, 1, 0, R"(//  \\|_|//  \\/ \//  \\   __   _||  ||   )");
+		mvwaddstr(bigstring_message_window, 2, 0, R"(||     _ ||  ||| |||  ||\//  \\| \\__//_  )");
+		mvwaddstr(bigstring_message_window, 3, 0, R"(\\__  | |\\__//\_|\\__//|||  ||| |//___ \\)");
+		mvwaddstr(bigstring_message_window, 4, 0, R"(    \\| |  //\\  |//\\  |\\__//| |||___\||)");
+		mvwaddstr(bigstring_message_window, 5, 0, R"(    ||| | //  \\ |/  \\ |      | |||      )");
+		mvwaddstr(bigstring_message_window, 6, 0, R"(\\__//|_|//    \|/    \\|      \_\\\____//)");
+		mvwaddstr(bigstring_message_window, 0, 35, "\304\304");
+	} else {
+		mvwaddstr(bigstring_message_window, 0, 0, R"(  __   _                                  )");
+		mvwaddstr(bigstring_message_window, 1, 0, R"(//  \\|_|                  __   _         )");
+		mvwaddstr(bigstring_message_window, 2, 0, R"(||     _                \//  \\| |  ____  )");
+		mvwaddstr(bigstring_message_window, 3, 0, R"(\\__  | |               |||  ||| |//___ \\)");
+		mvwaddstr(bigstring_message_window, 4, 0, R"(    \\| |  //\\   //\\  |\\__//| |||___\||)");
+		mvwaddstr(bigstring_message_window, 5, 0, R"(    ||| | //  \\ //  \\ |      | |||      )");
+		mvwaddstr(bigstring_message_window, 6, 0, R"(\\__//|_|//    \|/    \\|      \_\\\____//)");
+	}
+
+	mvwaddstr(credit_apo_message_window, 0, 0, "Devs at Apo-Games for original game");
+	mvwaddstr(credit_apo_message_window, 1, 0, "        http://goo.gl/QKqIK1       ");
+
+	mvwaddstr(credit_me_message_window, 0, 0, "                 Repo at GitHub                 ");
+	mvwaddstr(credit_me_message_window, 1, 0, "https://github.com/nabijaczleweli/apoSimpleSmart");
+
+	mvwaddstr(credit_cereal_message_window, 0, 0, "       USCiLab for cereal      ");
+	mvwaddstr(credit_cereal_message_window, 1, 0, "http://uscilab.github.io/cereal");
+}
+
+void creditsscreen::run() {
+	show();
+	doupdate();
+	wait_for_menu(window.get());
+}
+
+
+optionsscreen::optionsscreen(WINDOW * pparent_window) : retained_screen(pparent_window), name_editbox_window(nullptr) {}
+
+void optionsscreen::build(int maxY, int maxX) {
+	const auto menu_button_window       = child(3, 6, maxY - 3, maxX - 6);
+	const auto bigstring_message_window = child(7, 21, (maxY - 7) / 2, (maxX - 21) / 2);
+	name_editbox_window                 = child(3, game_data::max_name_length + 2, 0, (maxX - (game_data::max_name_length + 2)) / 2);
+
+	draw_menu_button(menu_button_window);
+	mvwaddstr(bigstring_message_window, 0, 0, R"(           __        )");
+	mvwaddstr(bigstring_message_window, 1, 0, R"(        \//  \\      )");
+	mvwaddstr(bigstring_message_window, 2, 0, R"(  __    |||  ||  __  )");
+	mvwaddstr(bigstring_message_window, 3, 0, R"(//  \\/ |\\__////  \\)");
+	mvwaddstr(bigstring_message_window, 4, 0, R"(||  ||| |      ||  ||)");
+	mvwaddstr(bigstring_message_window, 5, 0, R"(\\__//\_|      \\__//)");
+	wborder(name_editbox_window, ACS_VLINE, ACS_VLINE, ACS_HLINE, ACS_HLINE, ACS_ULCORNER, ACS_URCORNER, ACS_LLCORNER, ACS_LRCORNER);
+	mvwaddstr(name_editbox_window, 0, 1, "Name");
+}
+
+string optionsscreen::run(const string & name) {
+	show();
+
+	int maxX = -1;
+	int maxY = -1;
+
+	raw();
+	nonl();
+	cbreak();
+	bool exited    = false;
+	int selected   = 1;
+	string newname = name;
+	while(!exited) {
+		selected %= 2;
+		if(!selected) {
+			curs_set(0);
+			switch(wgetch(window.get())) {
+				case 'm':
+				case 'M':
+				case CARRIAGE_RETURN:
+					exited = true;
+					break;
+				case TAB:
+					++selected;
+					break;
+			}
+		} else if(selected == 1) {
+			if(maxX == -1 || maxY == -1) {
+				curs_set(1);
+				getmaxyx(name_editbox_window, maxY, maxX);
+				wmove(name_editbox_window, 1, 1);
+				for(int i = 0; i < maxX - 2; ++i)
+					waddch(name_editbox_window, ' ');
+				mvwaddstr(name_editbox_window, 1, 1, newname.c_str());
+				wnoutrefresh(name_editbox_window);
+				doupdate();
+			}
+			const char c = wgetch(name_editbox_window);
+			if(c == ERR)
+				continue;
+			else if(c == KEY_ESC) {
+				selected = 0;
+				maxX     = -1;
+				maxY     = -1;
+				continue;
+			} else if(c == TAB) {
+				++selected;
+				maxX = -1;
+				maxY = -1;
+				continue;
+			} else if(c == CARRIAGE_RETURN) {
+				maxX = -1;
+				maxY = -1;
+				if((selected = (selected + 1) % 2))
+					selected = max(selected, 1);
+				else
+					exited = true;
+			} else if(c == BACKSPACE) {
+				if(newname.size()) {
+					newname.pop_back();
+					wprintw(name_editbox_window, "%c %c", BACKSPACE, BACKSPACE);
+					wnoutrefresh(name_editbox_window);
+					doupdate();
+				}
+			} else if(newname.size() < game_data::max_name_length) {
+				newname.push_back(c);
+				waddch(name_editbox_window, c);
+				wnoutrefresh(name_editbox_window);
+				doupdate();
+			}
+		}
+	}
+
+	return newname;
+}
+
+
+tutorialscreen::tutorialscreen(WINDOW * pparent_window) : retained_screen(pparent_window) {}
+
+void tutorialscreen::build(int maxY, int maxX) {
+	const auto menu_button_window       = child(3, 6, maxY - 3, maxX - 6);
+	const auto moving_message_window    = child(2, 37, 1, (maxX - 38) / 2);
+	const auto clearing_message_window  = child(2, 47, 3, (maxX - 48) / 2);
+	const auto direction_message_window = child(4, 33, maxY - 4, (maxX - 33) / 2);
+	const auto bigstring_message_window = child(8, 20, (maxY - 8) / 2, (maxX - 20) / 2);
+
+	draw_menu_button(menu_button_window);
+	mvwaddstr(bigstring_message_window, 0, 0, R"(          __    __  )");
+	mvwaddstr(bigstring_message_window, 1, 0, R"(        //  \\//  \\)");
+	mvwaddstr(bigstring_message_window, 2, 0, R"(        ||    ||    )");
+	mvwaddstr(bigstring_message_window, 3, 0, R"(  __    \\__  \\__  )");
+	mvwaddstr(bigstring_message_window, 4, 0, R"(//  \\/     \\    \\)");
+	mvwaddstr(bigstring_message_window, 5, 0, R"(||  |||     ||    ||)");
+	mvwaddstr(bigstring_message_window, 6, 0, R"(\\__//\_\\__//\\__//)");
+	mvwaddstr(moving_message_window, 0, 0, "  Start moving by touching on a piece");
+	mvwaddch(moving_message_window, 0, 0, right_pointing_moving_thing | COLOR_PAIR(COLOR_PAIR_WHITE));
+	mvwaddstr(clearing_message_window, 0, 0, "   Clear all colored pieces to finish the level");
+	mvwaddch(clearing_message_window, 0, 0, up_pointing_moving_thing | COLOR_PAIR(COLOR_PAIR_BLUE));
+	mvwaddch(clearing_message_window, 0, 1, left_pointing_moving_thing | COLOR_PAIR(COLOR_PAIR_RED));
+	mvwaddstr(direction_message_window, 0, 0, "                                 ");
+	mvwaddstr(direction_message_window, 1, 0, " Whenever a new piece is reached ");
+	mvwaddstr(direction_message_window, 2, 0, "movement changes to its direction");
+	mvwaddch(direction_message_window, 0, 15, down_pointing_moving_thing | COLOR_PAIR(COLOR_PAIR_WHITE));
+	mvwaddch(direction_message_window, 0, 16, up_pointing_moving_thing | COLOR_PAIR(COLOR_PAIR_GREEN));
+}
+
+void tutorialscreen::run() {
+	show();
+	doupdate();
+	wait_for_menu(window.get());
+}
+
+
+const size_t highscorescreen::maximal_score_width = to_string(numeric_limits<decltype(high_data::score)>::max() / 4).size();
+const size_t highscorescreen::maximal_whole_width =
+    game_data::max_name_length + 1 + maximal_score_width + 1 + to_string(numeric_limits<decltype(high_data::level)>::max() / 4).size();
+const string highscorescreen::row_format = "%-" + to_string(game_data::max_name_length) + "s|%-" + to_string(maximal_score_width) + "u|%hu";
+
+highscorescreen::highscorescreen(WINDOW * pparent_window)
+      : retained_screen(pparent_window), none_message_window(nullptr), position_message_window(nullptr), list_window(nullptr), list_height(0) {}
+
+void highscorescreen::build(int maxY, int maxX) {
+	const auto menu_button_window         = child(3, 6, maxY - 3, maxX - 6);
+	const auto description_message_window = child(2, maximal_whole_width, 0, (maxX - maximal_whole_width) / 2);
+	none_message_window                   = child(2, 23, maxY - 2, (maxX - 23) / 2);
+	position_message_window               = child(1, 23, maxY - 3, (maxX - 23) / 2);
+	list_height                           = max(maxY - 4, 1);
+	list_window                           = child(list_height, maximal_whole_width, 1, (maxX - maximal_whole_width) / 2);
+
+	draw_menu_button(menu_button_window);
+
+	wprintw(description_message_window, ("%-" + to_string(game_data::max_name_length) + "s|%-" + to_string(maximal_score_width) + "s|%s").c_str(), "Name",
+	        "Score", "Level");
+}
+
+template <class EntryAt>
+void highscorescreen::draw_rows(size_t count, const EntryAt & entry_at, size_t top) {
+	werase(list_window);
+	const auto bottom = min(count, top + list_height);
+	for(auto i = top; i < bottom; ++i) {
+		const auto & entry = entry_at(i);
+		mvwprintw(list_window, i - top, 0, row_format.c_str(), entry.name.c_str(), entry.score, entry.level);
+	}
+	wnoutrefresh(list_window);
+
+	werase(position_message_window);
+	if(count > static_cast<size_t>(list_height))
+		wprintw(position_message_window, "%lu-%lu of %lu", static_cast<unsigned long>(top + 1), static_cast<unsigned long>(bottom),
+		        static_cast<unsigned long>(count));
+	wnoutrefresh(position_message_window);
+
+	doupdate();
+}
+
+template <class EntryAt>
+void highscorescreen::run(size_t count, const EntryAt & entry_at) {
+	show();
+
+	werase(none_message_window);
+	if(!count)
+		mvwaddstr(none_message_window, 0, 0, "None yet, go make some.");
+	wnoutrefresh(none_message_window);
+
+	raw();
+	nonl();
+	cbreak();
+
+	size_t top = 0;
+	while(true) {
+		const size_t page     = list_height;
+		const size_t last_top = count > page ? count - page : 0;
+		top                   = min(top, last_top);
+		draw_rows(count, entry_at, top);
+
+		switch(wgetch(window.get())) {
+			case 'm':
+			case 'M':
+			case CARRIAGE_RETURN:
+				return;
+			case 'w':
+			case 'W':
+				if(top)
+					--top;
+				break;
+			case 's':
+			case 'S':
+				++top;
+				break;
+			case 'a':
+			case 'A':
+				top -= min(top, page);
+				break;
+			case 'd':
+			case 'D':
+				top += page;
+				break;
+			case KEY_RESIZE:
+				show();
+				break;
+		}
+	}
+}
+
+void highscorescreen::run(const game_data & gd) {
+	if(const auto index = gd.undecoded_highscores())
+		run(index->size(), [&](size_t position) { return (*index)[position]; });
+	else {
+		const auto & highscores = gd.highscore();
+		run(highscores.size(), [&](size_t position) -> const high_data & { return *highscores.find_by_rank(position); });
+	}
+}
@@ -0,0 +1,149 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016 nabijaczleweli
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+
+#include <string>
+#include <vector>
+
+#include "curses.hpp"
+#include "game_data.hpp"
+
+
+#define BACKSPACE '\x08'
+#define TAB '\x09'
+#define CARRIAGE_RETURN '\x0d'
+
+#define COLOR_PAIR_BLUE 1
+#define COLOR_PAIR_RED 2
+#define COLOR_PAIR_GREEN 3
+#define COLOR_PAIR_WHITE 4
+
+
+enum mainscreen_selection : char { start, tutorial, quit, credits, options, highscore };
+
+
+// A screen whose windows and static content are built once, in a window of its own over the parent,
+// and only re-shown on later visits; it's rebuilt only when the parent's size changes, as when the terminal's resized.
+class retained_screen {
+private:
+	int configured_width;
+	int configured_height;
+	int built_width;
+	int built_height;
+	std::vector<window_p> children;
+
+protected:
+	WINDOW * parent_window;
+	window_p window;
+
+
+	// Creates a subwindow of window that lives until the next rebuild
+	WINDOW * child(int lines, int cols, int begin_y, int begin_x);
+	virtual void build(int maxY, int maxX) = 0;
+
+public:
+	retained_screen(WINDOW * parent_window);
+	virtual ~retained_screen();
+
+	// Only stages the screen, so whatever the caller draws over it goes out with it in the caller's one doupdate()
+	void show();
+};
+
+
+class mainscreen : public retained_screen {
+private:
+	bool put_apo_in;
+
+protected:
+	virtual void build(int maxY, int maxX) override;
+
+public:
+	mainscreen(WINDOW * parent_window, bool put_apo_in);
+
+	mainscreen_selection choose();
+};
+
+class creditsscreen : public retained_screen {
+private:
+	bool put_apo_in;
+
+protected:
+	virtual void build(int maxY, int maxX) override;
+
+public:
+	creditsscreen(WINDOW * parent_window, bool put_apo_in);
+
+	void run();
+};
+
+class optionsscreen : public retained_screen {
+private:
+	WINDOW * name_editbox_window;
+
+protected:
+	virtual void build(int maxY, int maxX) override;
+
+public:
+	optionsscreen(WINDOW * parent_window);
+
+	std::string run(const std::string & name);
+};
+
+class tutorialscreen : public retained_screen {
+protected:
+	virtual void build(int maxY, int maxX) override;
+
+public:
+	tutorialscreen(WINDOW * parent_window);
+
+	void run();
+};
+
+class highscorescreen : public retained_screen {
+private:
+	static const std::size_t maximal_score_width;
+	static const std::size_t maximal_whole_width;
+	static const std::string row_format;
+
+	WINDOW * none_message_window;
+	WINDOW * position_message_window;
+	WINDOW * list_window;
+	int list_height;
+
+
+	// Draws only the entries [top, top + list_height) into list_window, getting each from entry_at(position)
+	template <class EntryAt>
+	void draw_rows(std::size_t count, const EntryAt & entry_at, std::size_t top);
+	template <class EntryAt>
+	void run(std::size_t count, const EntryAt & entry_at);
+
+protected:
+	virtual void build(int maxY, int maxX) override;
+
+public:
+	highscorescreen(WINDOW * parent_window);
+
+	// Highscores still in the save's index are decoded only as they're scrolled onto the screen
+	void run(const game_data & gd);
+};